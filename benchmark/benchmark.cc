@@ -1,10 +1,89 @@
 #define ANKERL_NANOBENCH_IMPLEMENT
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <jsoncpp/json/json.h>
 
 #include "../src/json_parser.hpp"
 #include "./nanobench.h"
 #include "./nlohmannJson.hpp"
 
+// 去掉字符串之外的所有空白, 得到同一文档的紧凑版本
+std::string minifyJson(const std::string& json) {
+  std::string out;
+  out.reserve(json.size());
+  bool inString = false;
+  for (size_t i = 0; i < json.size(); ++i) {
+    char c = json[i];
+    if (inString) {
+      out += c;
+      if (c == '\\' && i + 1 < json.size()) {
+        out += json[++i];
+      } else if (c == '"') {
+        inString = false;
+      }
+    } else if (c == '"') {
+      inString = true;
+      out += c;
+    } else if (c != ' ' && c != '\n' && c != '\r' && c != '\t') {
+      out += c;
+    }
+  }
+  return out;
+}
+
+// 统计所有整数的和: 建树后遍历
+int64_t sumTreeCounters(const yoyo::JsonValue& value) {
+  if (value.isInt()) return value.asInt();
+  int64_t sum = 0;
+  if (value.isArray()) {
+    for (const auto& item : value.getRef<yoyo::JsonValue::json_array>())
+      sum += sumTreeCounters(item);
+  } else if (value.isObject()) {
+    for (const auto& member : value.getRef<yoyo::JsonValue::json_object>())
+      sum += sumTreeCounters(member.second);
+  }
+  return sum;
+}
+
+// 统计所有整数的和: SAX 事件中直接累加, 不建树
+struct CounterSumHandler : yoyo::JsonSaxHandler {
+  int64_t sum{0};
+  bool int64(int64_t value) {
+    sum += value;
+    return true;
+  }
+};
+
+// 原 PrintJson 的做法: 逐行 std::endl 刷新, 循环输出缩进, 容器按值拷贝
+void printJsonLegacy(std::ostream& os, const yoyo::JsonFiled& jsonField,
+                     int indent = 0) {
+  auto printIndent = [&]() {
+    for (int i = 0; i < indent; ++i) os << "  ";
+  };
+  printIndent();
+  if (jsonField.isArray()) {
+    os << "[" << std::endl;
+    for (const auto& item : jsonField.get<yoyo::JsonFiled::json_array>()) {
+      printJsonLegacy(os, item, indent + 1);
+    }
+    printIndent();
+    os << "]" << std::endl;
+  } else if (jsonField.isObject()) {
+    os << "{" << std::endl;
+    for (const auto& [key, value] :
+         jsonField.get<yoyo::JsonFiled::json_object>()) {
+      printIndent();
+      os << "\"" << key << "\": ";
+      printJsonLegacy(os, value, indent + 1);
+    }
+    printIndent();
+    os << "}" << std::endl;
+  } else {
+    os << jsonField.writeToString() << std::endl;
+  }
+}
+
 int main() {
   // 打开 JSON 文件
   std::ifstream inputFile("./test_data.json");
@@ -43,6 +122,536 @@ int main() {
     ankerl::nanobench::doNotOptimizeAway(jValue);
   });
 
+  // 缩进版与紧凑版对比, 按字节吞吐量输出
+  std::string minifiedString = minifyJson(jsonString);
+  ankerl::nanobench::Bench wsBench;
+  wsBench.title("whitespace skipping").unit("byte").relative(true);
+  wsBench.batch(jsonString.size()).run("indented", [&jsonString] {
+    yoyo::JsonValue jValue = yoyo::parserJson(jsonString);
+    ankerl::nanobench::doNotOptimizeAway(jValue);
+  });
+  wsBench.batch(minifiedString.size()).run("minified", [&minifiedString] {
+    yoyo::JsonValue jValue = yoyo::parserJson(minifiedString);
+    ankerl::nanobench::doNotOptimizeAway(jValue);
+  });
+
+  // 递归解析与两阶段 (结构字符索引) 解析对比
+  ankerl::nanobench::Bench modeBench;
+  modeBench.title("parse mode").unit("byte").relative(true);
+  modeBench.batch(jsonString.size());
+  modeBench.run("recursive", [&jsonString] {
+    yoyo::JsonValue jValue = yoyo::parserJson(jsonString);
+    ankerl::nanobench::doNotOptimizeAway(jValue);
+  });
+  modeBench.run("indexed", [&jsonString] {
+    yoyo::JsonValue jValue =
+        yoyo::parserJson(jsonString, yoyo::PARSEMODE::PARSE_INDEXED);
+    ankerl::nanobench::doNotOptimizeAway(jValue);
+  });
+  modeBench.run("iterative", [&jsonString] {
+    yoyo::JsonValue jValue =
+        yoyo::parserJson(jsonString, yoyo::PARSEMODE::PARSE_ITERATIVE);
+    ankerl::nanobench::doNotOptimizeAway(jValue);
+  });
+  modeBench.run("borrowed strings", [&jsonString] {
+    yoyo::JsonValue jValue = yoyo::parserJsonBorrowed(jsonString);
+    ankerl::nanobench::doNotOptimizeAway(jValue);
+  });
+  modeBench.run("lazy scalars", [&jsonString] {
+    yoyo::JsonValue jValue = yoyo::parserJsonLazy(jsonString);
+    ankerl::nanobench::doNotOptimizeAway(jValue);
+  });
+  yoyo::JsonKeyDict keyDict;  // 跨文档共享, 键只在第一次解析时分配
+  modeBench.run("interned keys", [&jsonString, &keyDict] {
+    yoyo::JsonValue jValue = yoyo::parserJsonInterned(jsonString, keyDict);
+    ankerl::nanobench::doNotOptimizeAway(jValue);
+  });
+  yoyo::JsonArena arena;  // 每次解析后 reset, 稳定后不再调用 malloc
+  modeBench.run("arena", [&jsonString, &arena] {
+    const yoyo::JsonValue& jValue = yoyo::parserJsonArena(jsonString, arena);
+    ankerl::nanobench::doNotOptimizeAway(jValue);
+    arena.reset();
+  });
+  yoyo::Document document;  // 复用同一个 Document, 稳定后不再分配内存
+  modeBench.run("tape document", [&jsonString, &document] {
+    document.parse(jsonString);
+    ankerl::nanobench::doNotOptimizeAway(document);
+  });
+
+  // 解析后原样写回: 延迟解码的标量直接输出原文
+  ankerl::nanobench::Bench roundTripBench;
+  roundTripBench.title("parse + serialize").unit("byte").relative(true);
+  roundTripBench.batch(jsonString.size());
+  roundTripBench.run("eager", [&jsonString] {
+    std::string out = yoyo::parserJson(jsonString).writeToString();
+    ankerl::nanobench::doNotOptimizeAway(out);
+  });
+  roundTripBench.run("lazy scalars", [&jsonString] {
+    std::string out = yoyo::parserJsonLazy(jsonString).writeToString();
+    ankerl::nanobench::doNotOptimizeAway(out);
+  });
+
+  // 宽文档 (大量小数组/对象) 上递归与显式栈状态机的对比
+  std::string wideString = "[";
+  for (int i = 0; i < 2000; ++i) {
+    if (i != 0) wideString += ",";
+    wideString += R"({"id":)" + std::to_string(i) +
+                  R"(,"tags":["a","b"],"pos":[1,2,3]})";
+  }
+  wideString += "]";
+  ankerl::nanobench::Bench wideBench;
+  wideBench.title("wide document").unit("byte").relative(true);
+  wideBench.minEpochIterations(10);
+  wideBench.batch(wideString.size());
+  wideBench.run("recursive", [&wideString] {
+    yoyo::JsonValue jValue = yoyo::parserJson(wideString);
+    ankerl::nanobench::doNotOptimizeAway(jValue);
+  });
+  wideBench.run("iterative", [&wideString] {
+    yoyo::JsonValue jValue =
+        yoyo::parserJson(wideString, yoyo::PARSEMODE::PARSE_ITERATIVE);
+    ankerl::nanobench::doNotOptimizeAway(jValue);
+  });
+
+  // 短字符串密集的文档: 状态、类型、来源等枚举值和短键都能内联存放
+  const char* shortStates[] = {"INIT", "UP", "DOWN", "TRY_CONNECT"};
+  const char* shortSources[] = {"learned", "configured", "logical"};
+  std::string shortString = "[";
+  for (int i = 0; i < 2000; ++i) {
+    if (i != 0) shortString += ",";
+    shortString += R"({"name":"rdkafka#c-)" + std::to_string(i % 16) +
+                   R"(","type":"consumer","state":")" + shortStates[i % 4] +
+                   R"(","source":")" + shortSources[i % 3] +
+                   R"(","nodeid":)" + std::to_string(i % 7) + "}";
+  }
+  shortString += "]";
+  yoyo::JsonValue shortTree = yoyo::parserJson(shortString);
+  std::cout << "short-string corpus: " << shortString.size() << " bytes, DOM "
+            << shortTree.memoryUsage() << " bytes" << std::endl;
+  ankerl::nanobench::Bench shortBench;
+  shortBench.title("short strings").unit("byte").relative(true);
+  shortBench.minEpochIterations(10);
+  shortBench.batch(shortString.size());
+  shortBench.run("nlohmann", [&shortString] {
+    nlohmann::json j = nlohmann::json::parse(shortString);
+    ankerl::nanobench::doNotOptimizeAway(j);
+  });
+  shortBench.run("yoyo inline", [&shortString] {
+    yoyo::JsonValue jValue = yoyo::parserJson(shortString);
+    ankerl::nanobench::doNotOptimizeAway(jValue);
+  });
+  shortBench.run("yoyo borrowed", [&shortString] {
+    yoyo::JsonValue jValue = yoyo::parserJsonBorrowed(shortString);
+    ankerl::nanobench::doNotOptimizeAway(jValue);
+  });
+  shortBench.run("yoyo copy tree", [&shortTree] {
+    yoyo::JsonValue jValue = shortTree;
+    ankerl::nanobench::doNotOptimizeAway(jValue);
+  });
+
+  // 数字密集的文档: 微秒时间戳和字节计数器
+  std::string numberString = "[";
+  std::vector<std::string> numberTokens;
+  for (int i = 0; i < 4000; ++i) {
+    uint64_t value = i % 2 == 0 ? 1700000000000000ULL + i * 7919ULL
+                                : static_cast<uint64_t>(i) * 104729ULL;
+    numberTokens.push_back(std::to_string(value));
+    if (i != 0) numberString += ",";
+    numberString += numberTokens.back();
+  }
+  numberString += "]";
+  ankerl::nanobench::Bench numberBench;
+  numberBench.title("integer parsing").unit("number").relative(true);
+  numberBench.batch(numberTokens.size());
+  numberBench.run("copy + std::stoll", [&numberTokens] {
+    int64_t sum = 0;  // 原实现的做法: 拷贝出临时字符串再转换
+    for (const std::string& token : numberTokens) {
+      sum += std::stoll(std::string(token.data(), token.size()));
+    }
+    ankerl::nanobench::doNotOptimizeAway(sum);
+  });
+  numberBench.run("std::from_chars", [&numberTokens] {
+    int64_t sum = 0;
+    for (const std::string& token : numberTokens) {
+      int64_t value = 0;
+      std::from_chars(token.data(), token.data() + token.size(), value);
+      sum += value;
+    }
+    ankerl::nanobench::doNotOptimizeAway(sum);
+  });
+  numberBench.run("SWAR digits", [&numberTokens] {
+    uint64_t sum = 0;
+    for (const std::string& token : numberTokens) {
+      size_t pos = 0;
+      uint64_t value = 0;
+      yoyo::detail::tryParseDigits(token.data(), token.size(), pos, value);
+      sum += value;
+    }
+    ankerl::nanobench::doNotOptimizeAway(sum);
+  });
+  numberBench.run("yoyo document", [&numberString] {
+    yoyo::JsonValue jValue = yoyo::parserJson(numberString);
+    ankerl::nanobench::doNotOptimizeAway(jValue);
+  });
+  numberBench.run("nlohmann document", [&numberString] {
+    nlohmann::json j = nlohmann::json::parse(numberString);
+    ankerl::nanobench::doNotOptimizeAway(j);
+  });
+
+  // 浮点密集的文档: 经纬度坐标和延迟分位数
+  std::string floatString = "[";
+  std::vector<std::string> floatTokens;
+  uint64_t seed = 0x2545F4914F6CDD1DULL;
+  auto nextRandom = [&seed] {
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    return static_cast<double>(seed >> 11) / 9007199254740992.0;  // [0, 1)
+  };
+  char floatBuffer[64];
+  for (int i = 0; i < 1000; ++i) {
+    const double fields[] = {nextRandom() * 180 - 90, nextRandom() * 360 - 180,
+                             nextRandom() * 2, nextRandom() * 50,
+                             nextRandom() * 1e-3};
+    const char* formats[] = {"%.6f", "%.6f", "%.3f", "%.3f", "%.17g"};
+    const char* names[] = {"lat", "lng", "p50", "p99", "avg"};
+    floatString += i == 0 ? "{" : ",{";
+    for (int f = 0; f < 5; ++f) {
+      std::snprintf(floatBuffer, sizeof(floatBuffer), formats[f], fields[f]);
+      floatTokens.push_back(floatBuffer);
+      floatString += std::string(f == 0 ? "\"" : ",\"") + names[f] +
+                     "\":" + floatBuffer;
+    }
+    floatString += "}";
+  }
+  floatString += "]";
+  size_t mismatches = 0;  // 与 strtod 逐位比较
+  for (const std::string& token : floatTokens) {
+    size_t pos = 0;
+    double value = 0;
+    yoyo::detail::tryParseDouble(token.data(), token.size(), pos, value);
+    double expected = std::strtod(token.c_str(), nullptr);
+    mismatches += std::memcmp(&value, &expected, sizeof(value)) != 0;
+  }
+  std::cout << "float corpus: " << floatTokens.size() << " numbers, "
+            << mismatches << " differ from strtod" << std::endl;
+  ankerl::nanobench::Bench floatBench;
+  floatBench.title("float parsing").unit("number").relative(true);
+  floatBench.minEpochIterations(10);
+  floatBench.batch(floatTokens.size());
+  floatBench.run("std::strtod", [&floatTokens] {
+    double sum = 0;
+    for (const std::string& token : floatTokens) {
+      sum += std::strtod(token.c_str(), nullptr);
+    }
+    ankerl::nanobench::doNotOptimizeAway(sum);
+  });
+  floatBench.run("std::from_chars", [&floatTokens] {
+    double sum = 0;
+    for (const std::string& token : floatTokens) {
+      double value = 0;
+      std::from_chars(token.data(), token.data() + token.size(), value);
+      sum += value;
+    }
+    ankerl::nanobench::doNotOptimizeAway(sum);
+  });
+  floatBench.run("yoyo tryParseDouble", [&floatTokens] {
+    double sum = 0;
+    for (const std::string& token : floatTokens) {
+      size_t pos = 0;
+      double value = 0;
+      yoyo::detail::tryParseDouble(token.data(), token.size(), pos, value);
+      sum += value;
+    }
+    ankerl::nanobench::doNotOptimizeAway(sum);
+  });
+  floatBench.run("yoyo document", [&floatString] {
+    yoyo::JsonValue jValue = yoyo::parserJson(floatString);
+    ankerl::nanobench::doNotOptimizeAway(jValue);
+  });
+  floatBench.run("yoyo lazy scalars", [&floatString] {
+    yoyo::JsonValue jValue = yoyo::parserJsonLazy(floatString);
+    ankerl::nanobench::doNotOptimizeAway(jValue);
+  });
+  floatBench.run("nlohmann document", [&floatString] {
+    nlohmann::json j = nlohmann::json::parse(floatString);
+    ankerl::nanobench::doNotOptimizeAway(j);
+  });
+
+  // 指标导出: 整数和浮点数的输出
+  std::vector<int64_t> metricInts;
+  for (const std::string& token : numberTokens) {
+    metricInts.push_back(std::stoll(token));
+  }
+  std::vector<double> metricDoubles;
+  for (const std::string& token : floatTokens) {
+    metricDoubles.push_back(std::strtod(token.c_str(), nullptr));
+  }
+  yoyo::JsonValue floatDocument = yoyo::parserJson(floatString);
+  ankerl::nanobench::Bench formatBench;
+  formatBench.title("number formatting").unit("number").relative(true);
+  formatBench.batch(metricInts.size() + metricDoubles.size());
+  formatBench.run("std::to_string", [&metricInts, &metricDoubles] {
+    size_t bytes = 0;  // 原实现的做法, 浮点数只保留 6 位小数
+    for (int64_t value : metricInts) bytes += std::to_string(value).size();
+    for (double value : metricDoubles) bytes += std::to_string(value).size();
+    ankerl::nanobench::doNotOptimizeAway(bytes);
+  });
+  formatBench.run("snprintf %.17g", [&metricInts, &metricDoubles] {
+    char buffer[32];  // 能往返但不是最短
+    size_t bytes = 0;
+    for (int64_t value : metricInts) {
+      bytes += std::snprintf(buffer, sizeof(buffer), "%lld",
+                             static_cast<long long>(value));
+    }
+    for (double value : metricDoubles) {
+      bytes += std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+    }
+    ankerl::nanobench::doNotOptimizeAway(bytes);
+  });
+  formatBench.run("yoyo shortest", [&metricInts, &metricDoubles] {
+    char buffer[yoyo::detail::NUMBER_BUFFER_SIZE];  // 两位数字表 + 最短往返
+    size_t bytes = 0;
+    for (int64_t value : metricInts) {
+      bytes += yoyo::detail::writeInt(buffer, value) - buffer;
+    }
+    for (double value : metricDoubles) {
+      bytes += yoyo::detail::writeDouble(buffer, value) - buffer;
+    }
+    ankerl::nanobench::doNotOptimizeAway(bytes);
+  });
+  ankerl::nanobench::Bench().run(
+      "serialize float document", [&floatDocument] {
+        std::string out = floatDocument.writeToString();
+        ankerl::nanobench::doNotOptimizeAway(out);
+      });
+
+  // 同一棵树输出到不同的目标
+  yoyo::JsonValue statsTree = yoyo::parserJson(jsonString);
+  nlohmann::json statsJson = nlohmann::json::parse(jsonString);
+  std::string reusedOut;
+  std::vector<char> fixedOut(jsonString.size() * 2);
+  std::FILE* devNull = std::fopen("/dev/null", "w");
+  ankerl::nanobench::Bench writeBench;
+  writeBench.title("serialize").unit("byte").relative(true);
+  writeBench.batch(statsTree.writeToString().size());
+  writeBench.run("nlohmann dump", [&statsJson] {
+    std::string out = statsJson.dump();
+    ankerl::nanobench::doNotOptimizeAway(out);
+  });
+  writeBench.run("writeToString", [&statsTree] {
+    std::string out = statsTree.writeToString();
+    ankerl::nanobench::doNotOptimizeAway(out);
+  });
+  writeBench.run("reused string sink", [&statsTree, &reusedOut] {
+    reusedOut.clear();  // 保留容量, 稳定后不再分配
+    yoyo::StringSink sink(reusedOut);
+    yoyo::writeJson(statsTree, sink);
+    ankerl::nanobench::doNotOptimizeAway(reusedOut);
+  });
+  writeBench.run("buffer sink", [&statsTree, &fixedOut] {
+    yoyo::BufferSink sink(fixedOut.data(), fixedOut.size());
+    yoyo::writeJson(statsTree, sink);
+    ankerl::nanobench::doNotOptimizeAway(sink);
+  });
+  if (devNull != nullptr) {
+    writeBench.run("fd sink (/dev/null)", [&statsTree, devNull] {
+      yoyo::FdSink sink(fileno(devNull));
+      yoyo::writeJson(statsTree, sink);
+    });
+    std::fclose(devNull);
+  }
+
+  // 格式化输出 (调试时转储配置)
+  std::ofstream nullStream("/dev/null");
+  yoyo::JsonWriteOptions prettyOptions;
+  prettyOptions.pretty = true;
+  ankerl::nanobench::Bench prettyBench;
+  prettyBench.title("pretty print").unit("byte").relative(true);
+  prettyBench.minEpochIterations(10);
+  prettyBench.batch(statsTree.writeToString(prettyOptions).size());
+  prettyBench.run("legacy PrintJson", [&statsTree, &nullStream] {
+    printJsonLegacy(nullStream, statsTree);
+  });
+  prettyBench.run("nlohmann dump(2)", [&statsJson] {
+    std::string out = statsJson.dump(2);
+    ankerl::nanobench::doNotOptimizeAway(out);
+  });
+  prettyBench.run("pretty writer", [&statsTree, &reusedOut, &prettyOptions] {
+    reusedOut.clear();
+    yoyo::StringSink sink(reusedOut);
+    yoyo::writeJson(statsTree, sink, prettyOptions);
+    ankerl::nanobench::doNotOptimizeAway(reusedOut);
+  });
+
+  // 字符串密集的输出: 日志行, 少量引号、制表符和换行需要转义
+  yoyo::JsonValue logLines;
+  const char* logTemplates[] = {
+      "2024-05-01T12:00:%02d.123Z INFO  request handled path=/api/v1/items "
+      "status=200 latency_ms=%d user_agent=\"curl/8.0\"",
+      "2024-05-01T12:00:%02d.456Z WARN  slow query\ttook %d ms: SELECT * "
+      "FROM events WHERE id > 1000 ORDER BY ts DESC LIMIT 100",
+      "2024-05-01T12:00:%02d.789Z ERROR upstream timeout after %d ms\n"
+      "    at Connection.read (net.js:42)\n    at Socket.emit (events.js:7)"};
+  std::vector<std::string> logStrings;
+  char logBuffer[256];
+  for (int i = 0; i < 2000; ++i) {
+    std::snprintf(logBuffer, sizeof(logBuffer), logTemplates[i % 3], i % 60,
+                  i * 7 % 1000);
+    logStrings.push_back(logBuffer);
+    logLines.push_back(yoyo::JsonValue(logBuffer));
+  }
+  nlohmann::json logJson = nlohmann::json::parse(logLines.writeToString());
+  std::string logOut;
+  ankerl::nanobench::Bench escapeBench;
+  escapeBench.title("string escaping").unit("byte").relative(true);
+  escapeBench.minEpochIterations(10);
+  escapeBench.batch(logLines.writeToString().size());
+  escapeBench.run("per-char switch", [&logStrings, &logOut] {
+    logOut.clear();  // 原实现的做法: 逐字符判断, 逐字符追加
+    for (const std::string& line : logStrings) {
+      logOut += '"';
+      for (char c : line) {
+        switch (c) {
+          case '"':
+            logOut += "\\\"";
+            break;
+          case '\\':
+            logOut += "\\\\";
+            break;
+          case '\n':
+            logOut += "\\n";
+            break;
+          case '\t':
+            logOut += "\\t";
+            break;
+          default:
+            logOut += c;
+        }
+      }
+      logOut += "\",";
+    }
+    ankerl::nanobench::doNotOptimizeAway(logOut);
+  });
+  escapeBench.run("nlohmann dump", [&logJson] {
+    std::string out = logJson.dump();
+    ankerl::nanobench::doNotOptimizeAway(out);
+  });
+  escapeBench.run("yoyo SIMD escaper", [&logLines, &logOut] {
+    logOut.clear();
+    yoyo::StringSink sink(logOut);
+    yoyo::writeJson(logLines, sink);
+    ankerl::nanobench::doNotOptimizeAway(logOut);
+  });
+
+  // 坏记录: 抛异常与返回错误码的开销对比
+  std::string badRecord = R"({"name": "rdkafka", "ts": 12345, "tx": tru})";
+  ankerl::nanobench::Bench errorBench;
+  errorBench.title("malformed record").relative(true);
+  errorBench.run("exception", [&badRecord] {
+    try {
+      yoyo::JsonValue jValue = yoyo::parserJson(badRecord);
+      ankerl::nanobench::doNotOptimizeAway(jValue);
+    } catch (const yoyo::JsonParseError& e) {
+      ankerl::nanobench::doNotOptimizeAway(e);
+    }
+  });
+  errorBench.run("error code", [&badRecord] {
+    yoyo::JsonResult result = yoyo::tryParseJson(badRecord);
+    ankerl::nanobench::doNotOptimizeAway(result);
+  });
+
+  // 访问已解析的树: 按值返回 (深拷贝子树) vs 按引用访问
+  yoyo::JsonValue statsRoot = yoyo::parserJson(jsonString);
+  ankerl::nanobench::Bench accessBench;
+  accessBench.title("accessors").relative(true);
+  accessBench.run("asObject by value", [&statsRoot] {
+    size_t total = 0;
+    yoyo::JsonValue::json_object brokers = statsRoot["brokers"].asObject();
+    for (const auto& member : brokers) {
+      total += member.second["name"].asString().size();
+    }
+    ankerl::nanobench::doNotOptimizeAway(total);
+  });
+  accessBench.run("getRef + asStringView", [&statsRoot] {
+    size_t total = 0;
+    const auto& brokers =
+        statsRoot["brokers"].getRef<yoyo::JsonValue::json_object>();
+    for (const auto& member : brokers) {
+      total += member.second["name"].asStringView().size();
+    }
+    ankerl::nanobench::doNotOptimizeAway(total);
+  });
+
+  // 键查找: 每次构造 std::string 键 vs 直接用 string_view 查找
+  const char* brokerKey = "127.0.0.1:9092/1";
+  ankerl::nanobench::Bench lookupBench;
+  lookupBench.title("key lookup").relative(true);
+  lookupBench.run("std::string key", [&statsRoot, brokerKey] {
+    const yoyo::JsonValue& brokers = statsRoot["brokers"];
+    bool found = brokers.getRef<yoyo::JsonValue::json_object>().contains(
+        std::string(brokerKey));
+    ankerl::nanobench::doNotOptimizeAway(found);
+  });
+  lookupBench.run("find(string_view)", [&statsRoot, brokerKey] {
+    const yoyo::JsonValue* pBroker = statsRoot.find("brokers")->find(brokerKey);
+    ankerl::nanobench::doNotOptimizeAway(pBroker);
+  });
+
+  // 只聚合计数器: 建树后遍历 vs SAX 事件
+  ankerl::nanobench::Bench saxBench;
+  saxBench.title("aggregate counters").unit("byte").relative(true);
+  saxBench.batch(jsonString.size());
+  saxBench.run("tree + walk", [&jsonString] {
+    yoyo::JsonValue root = yoyo::parserJsonBorrowed(jsonString);
+    ankerl::nanobench::doNotOptimizeAway(sumTreeCounters(root));
+  });
+  saxBench.run("sax", [&jsonString] {
+    CounterSumHandler handler;
+    yoyo::JsonStatus status = yoyo::parserJsonSax(jsonString, handler);
+    ankerl::nanobench::doNotOptimizeAway(status);
+    ankerl::nanobench::doNotOptimizeAway(handler.sum);
+  });
+
+  // 只判断是否合法: 建树 vs 只校验
+  ankerl::nanobench::Bench validateBench;
+  validateBench.title("validate").unit("byte").relative(true);
+  validateBench.batch(jsonString.size());
+  validateBench.run("tryParseJson", [&jsonString] {
+    yoyo::JsonResult result = yoyo::tryParseJson(jsonString);
+    ankerl::nanobench::doNotOptimizeAway(result.ok());
+  });
+  validateBench.run("validateJson", [&jsonString] {
+    yoyo::JsonStatus status = yoyo::validateJson(jsonString);
+    ankerl::nanobench::doNotOptimizeAway(status);
+  });
+  validateBench.run("validateJson + utf8", [&jsonString] {
+    yoyo::JsonStatus status = yoyo::validateJson(jsonString, true);
+    ankerl::nanobench::doNotOptimizeAway(status);
+  });
+  validateBench.run("nlohmann accept", [&jsonString] {
+    bool ok = nlohmann::json::accept(jsonString);
+    ankerl::nanobench::doNotOptimizeAway(ok);
+  });
+
+  // 只读取少量字段: 完整建树后查找 vs 按需解析
+  ankerl::nanobench::Bench fieldBench;
+  fieldBench.title("read 5 fields").relative(true);
+  fieldBench.run("full tree", [&jsonString] {
+    yoyo::JsonValue root = yoyo::parserJson(jsonString);
+    yoyo::JsonValue& broker = root["brokers"]["127.0.0.1:9092/1"];
+    int sum = root["ts"].asInt() + root["msg_cnt"].asInt() +
+              broker["rtt"]["avg"].asInt() + broker["tx"].asInt() +
+              broker["rx"].asInt();
+    ankerl::nanobench::doNotOptimizeAway(sum);
+  });
+  fieldBench.run("lazy", [&jsonString] {
+    yoyo::LazyValue root(jsonString);
+    yoyo::LazyValue broker = root["brokers"]["127.0.0.1:9092/1"];
+    int64_t sum = root["ts"].asInt() + root["msg_cnt"].asInt() +
+                  broker["rtt"]["avg"].asInt() + broker["tx"].asInt() +
+                  broker["rx"].asInt();
+    ankerl::nanobench::doNotOptimizeAway(sum);
+  });
+
   ankerl::nanobench::Bench().run("jsoncpp", [&jsonString] {
     Json::Value root;
     Json::CharReaderBuilder builder;
@@ -1,19 +1,54 @@
 #ifndef __YOYO_JSON_PARSER_HPP__
 #define __YOYO_JSON_PARSER_HPP__
+#include <cerrno>
+#include <cfloat>
+#include <charconv>
+#include <climits>
+#include <cmath>
 #include <cstddef>
-#include <iomanip>
+#include <cstdint>
+#include <cstring>
+#include <deque>
 #include <iostream>
-#include <map>
+#include <limits>
+#include <mutex>
+#include <new>
+#include <shared_mutex>
+#include <stdexcept>
 #include <string>
 #include <string_view>
-#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <variant>
 #include <vector>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define YOYO_JSON_AVX2 1
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define YOYO_JSON_SSE2 1
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+// FdSink 使用的 write
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+// SWAR 数字解析按小端字节序把 8 个字节装入一个 64 位整数
+#if defined(_MSC_VER) || \
+    (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define YOYO_JSON_LITTLE_ENDIAN 1
+#endif
+
 namespace yoyo {
 
-enum class JSONTYPE {
+enum class JSONTYPE : uint8_t {
   JSON_ARRAY,    // array
   JSON_NULL,     // NULL
   JSON_NUMBER,   // 数字 -, e, 0-9
@@ -24,114 +59,762 @@ enum class JSONTYPE {
 };
 
 using jValueType = JSONTYPE;
+
+// 带填充缓冲区在有效数据之后至少需要的可读字节数
+inline constexpr size_t JSON_PADDING = 64;
+
+enum class PARSEMODE {
+  // 以下两种模式每层容器都递归, 嵌套深度另受 MAX_RECURSIVE_DEPTH 限制
+  PARSE_RECURSIVE,  // 逐字节递归下降 (参考实现)
+  PARSE_INDEXED,    // 两阶段: SIMD 构建结构字符索引后再建树
+  PARSE_ITERATIVE   // 显式栈状态机, 不递归, 嵌套深度只受 setMaxDepth 限制
+};
+
+// 不抛异常的解析接口返回的错误码, 见 JsonParser::tryParse
+enum class JSONERROR {
+  ERROR_NONE,
+  ERROR_EMPTY_INPUT,
+  ERROR_UNEXPECTED_END,       // 输入在值或字符串结束前截断
+  ERROR_INVALID_VALUE,        // 不是合法的值起始字符, 或值之后紧跟非法字符
+  ERROR_INVALID_LITERAL,      // null/true/false 拼写错误
+  ERROR_INVALID_NUMBER,       // 数字语法错误
+  ERROR_NUMBER_OUT_OF_RANGE,  // 数字超出可表示范围
+  ERROR_INVALID_STRING,       // 非法转义或未转义的控制字符
+  ERROR_EXPECTED_KEY,         // 对象中缺少字符串键
+  ERROR_EXPECTED_COLON,       // 键之后缺少 ':'
+  ERROR_EXPECTED_SEPARATOR,   // 元素之后缺少 ',' 或闭合括号
+  ERROR_DUPLICATE_KEY,
+  ERROR_DEPTH_EXCEEDED,
+  ERROR_TRAILING_CONTENT,  // 根值之后还有非空白内容
+  ERROR_INPUT_TOO_LARGE,   // 超出结构字符索引可寻址的范围 (4GB)
+  ERROR_ABORTED,           // SAX 处理器的事件返回 false, 解析提前停止
+  ERROR_INVALID_UTF8       // 不合法的 UTF-8 序列 (只在校验时要求检查)
+};
+
+inline const char* errorMessage(JSONERROR code) noexcept {
+  switch (code) {
+    case JSONERROR::ERROR_NONE:
+      return "no error";
+    case JSONERROR::ERROR_EMPTY_INPUT:
+      return "input JSON string is empty";
+    case JSONERROR::ERROR_UNEXPECTED_END:
+      return "unexpected end of input";
+    case JSONERROR::ERROR_INVALID_VALUE:
+      return "invalid JSON value";
+    case JSONERROR::ERROR_INVALID_LITERAL:
+      return "invalid literal, expected null, true or false";
+    case JSONERROR::ERROR_INVALID_NUMBER:
+      return "invalid number";
+    case JSONERROR::ERROR_NUMBER_OUT_OF_RANGE:
+      return "number out of range";
+    case JSONERROR::ERROR_INVALID_STRING:
+      return "invalid escape or control character in string";
+    case JSONERROR::ERROR_EXPECTED_KEY:
+      return "expected string key in object";
+    case JSONERROR::ERROR_EXPECTED_COLON:
+      return "expected ':' after object key";
+    case JSONERROR::ERROR_EXPECTED_SEPARATOR:
+      return "expected ',' or closing bracket";
+    case JSONERROR::ERROR_DUPLICATE_KEY:
+      return "duplicate key in JSON object";
+    case JSONERROR::ERROR_DEPTH_EXCEEDED:
+      return "maximum JSON depth exceeded";
+    case JSONERROR::ERROR_TRAILING_CONTENT:
+      return "unexpected content after JSON value";
+    case JSONERROR::ERROR_INPUT_TOO_LARGE:
+      return "input too large for structural index";
+    case JSONERROR::ERROR_ABORTED:
+      return "parsing stopped by handler";
+    case JSONERROR::ERROR_INVALID_UTF8:
+      return "invalid UTF-8 byte sequence";
+  }
+  return "unknown error";
+}
+
+enum class STRINGMODE {
+  STRING_COPY,    // 字符串值和键都拷贝为自己持有的 std::string (默认)
+  STRING_BORROW,  // 不含转义的字符串直接引用输入, 含转义的仍拷贝
+  STRING_INSITU   // 全部引用输入, 含转义的字符串在可写输入中原位解码
+};
+// 输出格式, 默认紧凑输出
+struct JsonWriteOptions {
+  bool pretty{false};               // 格式化输出: 换行并缩进
+  size_t indentWidth{2};            // 每层缩进的字符数
+  char indentChar{' '};             // 缩进字符, 如 ' ' 或 '\t'
+  bool compactScalarArrays{false};  // 只含标量的数组写在一行
+};
+
+// 单调增长的内存池: 从大块内存中顺序切分, 单次释放无效, 只能整体 reset/release
+// reset 保留已申请的内存块供下次解析复用, 稳定后不再调用 malloc
+class JsonArena {
+ public:
+  explicit JsonArena(size_t blockSize = 64 * 1024) : _iBlockSize(blockSize) {}
+  JsonArena(const JsonArena&) = delete;
+  JsonArena& operator=(const JsonArena&) = delete;
+  ~JsonArena() { release(); }
+
+  void* allocate(size_t size, size_t align = alignof(std::max_align_t)) {
+    while (_iCurrent < _vBlocks.size()) {
+      Block& block = _vBlocks[_iCurrent];
+      size_t offset = (_iOffset + align - 1) & ~(align - 1);
+      if (offset + size <= block.size) {
+        _iOffset = offset + size;
+        _iUsed += size;
+        return block.data + offset;
+      }
+      _iCurrent++;  // 当前块不够, 尝试下一块
+      _iOffset = 0;
+    }
+    size_t blockSize = _iBlockSize;
+    while (blockSize < size + align) blockSize *= 2;
+    _iBlockSize = blockSize * 2;  // 后续的块逐步变大
+    _vBlocks.push_back(Block{static_cast<char*>(::operator new(blockSize)),
+                             blockSize});
+    _iCurrent = _vBlocks.size() - 1;
+    _iOffset = 0;
+    return allocate(size, align);
+  }
+
+  template <class T, class... Args>
+  T* create(Args&&... args) {
+    return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+  }
+
+  // 丢弃所有分配但保留内存, 之前从 arena 得到的对象全部失效 (不调用析构)
+  // 有多个块时合并为一个足够大的块, 下次同等规模的解析只需一个块
+  void reset() {
+    if (_vBlocks.size() > 1) {
+      size_t total = bytesReserved();
+      release();
+      _vBlocks.push_back(
+          Block{static_cast<char*>(::operator new(total)), total});
+    }
+    _iCurrent = 0;
+    _iOffset = 0;
+    _iUsed = 0;
+  }
+
+  // 归还全部内存块
+  void release() {
+    for (Block& block : _vBlocks) ::operator delete(block.data);
+    _vBlocks.clear();
+    _iCurrent = 0;
+    _iOffset = 0;
+    _iUsed = 0;
+  }
+
+  size_t bytesUsed() const noexcept { return _iUsed; }
+  size_t bytesReserved() const noexcept {
+    size_t total = 0;
+    for (const Block& block : _vBlocks) total += block.size;
+    return total;
+  }
+  size_t blockCount() const noexcept { return _vBlocks.size(); }
+
+ private:
+  struct Block {
+    char* data;
+    size_t size;
+  };
+  std::vector<Block> _vBlocks;
+  size_t _iCurrent{0};  // 正在切分的块
+  size_t _iOffset{0};   // 当前块内已用字节
+  size_t _iUsed{0};
+  size_t _iBlockSize;
+};
+
+// JsonFiled 容器使用的分配器: 绑定 arena 时从 arena 分配且释放为空操作,
+// 未绑定 (默认) 时等同于全局 new/delete
+// 拷贝容器时回到全局分配, 移动时保留 arena
+template <class T>
+class ArenaAllocator {
+ public:
+  using value_type = T;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+
+  ArenaAllocator() noexcept = default;
+  explicit ArenaAllocator(JsonArena* arena) noexcept : _pArena(arena) {}
+  template <class U>
+  ArenaAllocator(const ArenaAllocator<U>& other) noexcept
+      : _pArena(other.arena()) {}
+
+  T* allocate(size_t n) {
+    if (_pArena) {
+      return static_cast<T*>(_pArena->allocate(n * sizeof(T), alignof(T)));
+    }
+    return static_cast<T*>(::operator new(n * sizeof(T)));
+  }
+  void deallocate(T* p, size_t) noexcept {
+    if (!_pArena) ::operator delete(p);
+  }
+  ArenaAllocator select_on_container_copy_construction() const noexcept {
+    return ArenaAllocator();
+  }
+
+  JsonArena* arena() const noexcept { return _pArena; }
+  template <class U>
+  bool operator==(const ArenaAllocator<U>& other) const noexcept {
+    return _pArena == other.arena();
+  }
+  template <class U>
+  bool operator!=(const ArenaAllocator<U>& other) const noexcept {
+    return _pArena != other.arena();
+  }
+
+ private:
+  JsonArena* _pArena{nullptr};
+};
+
+class JsonKeyDict;
+
+namespace detail {
+// std::string 在堆上占用的字节数, 短字符串存放在对象内部时为 0
+inline size_t stringHeapBytes(const std::string& str) noexcept {
+  static const size_t kInlineCapacity = std::string().capacity();
+  return str.capacity() > kInlineCapacity ? str.capacity() + 1 : 0;
+}
+}  // namespace detail
+
+// 对象的键 (24 字节): 不超过 INLINE_CAPACITY 字节的短键直接存放在键内,
+// 更长的键持有一块堆内存; 借用模式下只引用输入缓冲区中的字节 (不分配内存),
+// 此时键的生命周期与该缓冲区绑定
+// 驻留键引用 JsonKeyDict 中唯一的一份拷贝, 同一字典的驻留键之间只比较指针
+class JsonKey {
+ public:
+  static constexpr size_t INLINE_CAPACITY = 22;
+
+  JsonKey() noexcept = default;
+  JsonKey(const char* key) : JsonKey(std::string_view(key)) {}
+  JsonKey(const std::string& key) : JsonKey(std::string_view(key)) {}
+  JsonKey(std::string_view key) {
+    if (key.size() <= INLINE_CAPACITY) {
+      if (!key.empty()) std::memcpy(_sData, key.data(), key.size());
+      _sData[INLINE_CAPACITY] = static_cast<char>(key.size());
+      return;
+    }
+    checkSize(key.size());
+    char* pOwned = new char[key.size()];
+    std::memcpy(pOwned, key.data(), key.size());
+    setExternal(KIND::OWNED, pOwned, key.size(), nullptr);
+  }
+
+  // 只有持有堆内存的长键需要深拷贝
+  JsonKey(const JsonKey& other) {
+    if (other._eKind == KIND::OWNED) {
+      new (this) JsonKey(other.view());
+    } else {
+      copyBits(other);
+    }
+  }
+  JsonKey(JsonKey&& other) noexcept {
+    copyBits(other);
+    other.copyBits(JsonKey());
+  }
+  JsonKey& operator=(const JsonKey& other) {
+    if (this != &other) {
+      JsonKey tCopy(other);
+      swap(tCopy);
+    }
+    return *this;
+  }
+  JsonKey& operator=(JsonKey&& other) noexcept {
+    if (this != &other) {
+      JsonKey tMoved(std::move(other));
+      swap(tMoved);
+    }
+    return *this;
+  }
+  ~JsonKey() {
+    if (_eKind == KIND::OWNED) delete[] external();
+  }
+
+  void swap(JsonKey& other) noexcept {
+    char tTemp[sizeof(JsonKey)];
+    std::memcpy(tTemp, static_cast<void*>(this), sizeof(JsonKey));
+    copyBits(other);
+    std::memcpy(static_cast<void*>(&other), tTemp, sizeof(JsonKey));
+  }
+
+  // 构造一个引用外部字节的键, 调用方保证 key 在键的使用期间有效
+  static JsonKey borrow(std::string_view key) {
+    checkSize(key.size());
+    JsonKey tKey;
+    tKey.setExternal(KIND::BORROWED, key.data() ? key.data() : "", key.size(),
+                     nullptr);
+    return tKey;
+  }
+
+  // 借用和驻留的键都引用外部字节
+  bool isBorrowed() const noexcept {
+    return _eKind == KIND::BORROWED || _eKind == KIND::INTERNED;
+  }
+  bool isInterned() const noexcept { return _eKind == KIND::INTERNED; }
+  bool isInline() const noexcept { return _eKind == KIND::INLINE; }
+  std::string_view view() const noexcept {
+    if (_eKind == KIND::INLINE)
+      return std::string_view(_sData,
+                              static_cast<uint8_t>(_sData[INLINE_CAPACITY]));
+    return std::string_view(external(), externalSize());
+  }
+  std::string str() const { return std::string(view()); }
+  operator std::string_view() const noexcept { return view(); }
+  size_t size() const noexcept { return view().size(); }
+  // 自己持有的键在堆上占用的字节数
+  size_t heapBytes() const noexcept {
+    return _eKind == KIND::OWNED ? externalSize() : 0;
+  }
+
+  friend bool operator<(const JsonKey& lhs, const JsonKey& rhs) noexcept {
+    return lhs.view() < rhs.view();
+  }
+  friend bool operator==(const JsonKey& lhs, const JsonKey& rhs) noexcept {
+    if (lhs.isInterned() && rhs.isInterned() && lhs.dict() == rhs.dict())
+      return lhs.external() == rhs.external();
+    return lhs.view() == rhs.view();
+  }
+  friend bool operator!=(const JsonKey& lhs, const JsonKey& rhs) noexcept {
+    return !(lhs == rhs);
+  }
+  friend std::ostream& operator<<(std::ostream& os, const JsonKey& key) {
+    return os << key.view();
+  }
+
+ private:
+  friend class JsonKeyDict;
+
+  enum class KIND : uint8_t { INLINE, OWNED, BORROWED, INTERNED };
+
+  static void checkSize(size_t size) {
+    if (size > UINT32_MAX) throw std::length_error("JSON key too long");
+  }
+  void copyBits(const JsonKey& other) noexcept {
+    std::memcpy(static_cast<void*>(this), &other, sizeof(JsonKey));
+  }
+  // 非内联的键: _sData 依次存放字节指针、驻留字典、长度
+  void setExternal(KIND kind, const char* chars, size_t size,
+                   const JsonKeyDict* dict) noexcept {
+    uint32_t iSize = static_cast<uint32_t>(size);
+    std::memcpy(_sData, &chars, sizeof(chars));
+    std::memcpy(_sData + 8, &dict, sizeof(dict));
+    std::memcpy(_sData + 16, &iSize, sizeof(iSize));
+    _eKind = kind;
+  }
+  const char* external() const noexcept {
+    const char* chars;
+    std::memcpy(&chars, _sData, sizeof(chars));
+    return chars;
+  }
+  const JsonKeyDict* dict() const noexcept {
+    const JsonKeyDict* pDict;
+    std::memcpy(&pDict, _sData + 8, sizeof(pDict));
+    return pDict;
+  }
+  uint32_t externalSize() const noexcept {
+    uint32_t iSize;
+    std::memcpy(&iSize, _sData + 16, sizeof(iSize));
+    return iSize;
+  }
+
+  // 内联时前 INLINE_CAPACITY 字节为内容, 最后一个字节为长度
+  alignas(8) char _sData[INLINE_CAPACITY + 1]{};
+  KIND _eKind{KIND::INLINE};
+};
+
+// 键驻留字典: 每个不同的键只保存一份, 可以在多个文档、多个 parser 之间共享
+// 读多写少, 查找持共享锁, 只有首次出现的键才持独占锁插入; 驻留键引用字典中
+// 的字节, 字典必须比所有使用它的树活得久, 且字典只增不减
+class JsonKeyDict {
+ public:
+  JsonKeyDict() = default;
+  JsonKeyDict(const JsonKeyDict&) = delete;
+  JsonKeyDict& operator=(const JsonKeyDict&) = delete;
+
+  JsonKey intern(std::string_view key) {
+    {
+      std::shared_lock<std::shared_mutex> lock(_mutex);
+      auto it = _setKeys.find(key);
+      if (it != _setKeys.end()) return makeKey(*it);
+    }
+    std::unique_lock<std::shared_mutex> lock(_mutex);
+    auto it = _setKeys.find(key);  // 加锁间隙可能已被其他线程插入
+    if (it != _setKeys.end()) return makeKey(*it);
+    // deque 尾部插入不移动已有元素, 已驻留键的字节地址保持不变
+    const std::string& stored = _dKeys.emplace_back(key);
+    return makeKey(*_setKeys.insert(stored).first);
+  }
+
+  size_t size() const {
+    std::shared_lock<std::shared_mutex> lock(_mutex);
+    return _dKeys.size();
+  }
+
+ private:
+  JsonKey makeKey(std::string_view stored) const {
+    JsonKey::checkSize(stored.size());
+    JsonKey tKey;
+    tKey.setExternal(JsonKey::KIND::INTERNED, stored.data(), stored.size(),
+                     this);
+    return tKey;
+  }
+
+  mutable std::shared_mutex _mutex;
+  std::deque<std::string> _dKeys;
+  std::unordered_set<std::string_view> _setKeys;  // 指向 _dKeys 中的字节
+};
+
+// 对象成员容器: 键值对按插入顺序连续存放, 迭代顺序与编译器无关
+// 成员较少时按长度+内容线性查找 (通常只需比较几个 cache line),
+// 超过 INDEX_THRESHOLD 个成员后额外维护一个开放寻址哈希索引
+// 迭代得到的 first 不要修改, 否则索引失效
+template <class Value>
+class BasicJsonObject {
+ public:
+  using value_type = std::pair<JsonKey, Value>;
+  using allocator_type = ArenaAllocator<value_type>;
+  using member_list = std::vector<value_type, allocator_type>;
+  using iterator = typename member_list::iterator;
+  using const_iterator = typename member_list::const_iterator;
+  static constexpr size_t INDEX_THRESHOLD = 16;
+
+  BasicJsonObject() = default;
+  explicit BasicJsonObject(const allocator_type& alloc)
+      : _vMembers(alloc), _vIndex(ArenaAllocator<uint32_t>(alloc)) {}
+
+  iterator begin() noexcept { return _vMembers.begin(); }
+  iterator end() noexcept { return _vMembers.end(); }
+  const_iterator begin() const noexcept { return _vMembers.begin(); }
+  const_iterator end() const noexcept { return _vMembers.end(); }
+  size_t size() const noexcept { return _vMembers.size(); }
+  bool empty() const noexcept { return _vMembers.empty(); }
+  void reserve(size_t n) { _vMembers.reserve(n); }
+  size_t capacity() const noexcept { return _vMembers.capacity(); }
+  // 成员数组和哈希索引占用的字节数, 不含键和值自己持有的内存
+  size_t heapBytes() const noexcept {
+    return _vMembers.capacity() * sizeof(value_type) +
+           _vIndex.capacity() * sizeof(uint32_t);
+  }
+  allocator_type get_allocator() const { return _vMembers.get_allocator(); }
+
+  iterator find(std::string_view key) {
+    size_t pos = findPos(key);
+    return pos == npos ? end() : begin() + pos;
+  }
+  const_iterator find(std::string_view key) const {
+    size_t pos = findPos(key);
+    return pos == npos ? end() : begin() + pos;
+  }
+  size_t count(std::string_view key) const { return findPos(key) != npos; }
+  bool contains(std::string_view key) const { return findPos(key) != npos; }
+
+  Value& at(std::string_view key) {
+    size_t pos = findPos(key);
+    if (pos == npos) throw std::out_of_range("Key not found in JSON object.");
+    return _vMembers[pos].second;
+  }
+  const Value& at(std::string_view key) const {
+    size_t pos = findPos(key);
+    if (pos == npos) throw std::out_of_range("Key not found in JSON object.");
+    return _vMembers[pos].second;
+  }
+
+  // 键不存在时插入一个默认值
+  Value& operator[](std::string_view key) {
+    size_t pos = findPos(key);
+    if (pos != npos) return _vMembers[pos].second;
+    return append(JsonKey(key), Value()).second;
+  }
+
+  // 键已存在时不插入, 返回已有成员
+  std::pair<iterator, bool> emplace(JsonKey key, Value value) {
+    size_t pos = findKey(key);
+    if (pos != npos) return {begin() + pos, false};
+    append(std::move(key), std::move(value));
+    return {end() - 1, true};
+  }
+
+  // 删除后保持其余成员的相对顺序; 索引就地删除对应槽位, 不重建
+  size_t erase(std::string_view key) {
+    size_t pos = findPos(key);
+    if (pos == npos) return 0;
+    if (!_vIndex.empty()) eraseIndex(pos);
+    _vMembers.erase(_vMembers.begin() + pos);
+    if (_vMembers.size() <= INDEX_THRESHOLD) _vIndex.clear();
+    return 1;
+  }
+
+  void clear() noexcept {
+    _vMembers.clear();
+    _vIndex.clear();
+  }
+
+ private:
+  static constexpr size_t npos = static_cast<size_t>(-1);
+
+  static size_t hashKey(std::string_view key) noexcept {
+    return std::hash<std::string_view>()(key);
+  }
+
+  size_t findPos(std::string_view key) const noexcept {
+    if (_vIndex.empty()) {
+      for (size_t i = 0; i < _vMembers.size(); i++) {
+        std::string_view cur = _vMembers[i].first.view();
+        if (cur.size() == key.size() &&
+            std::memcmp(cur.data(), key.data(), key.size()) == 0)
+          return i;
+      }
+      return npos;
+    }
+    size_t mask = _vIndex.size() - 1;
+    for (size_t slot = hashKey(key) & mask;; slot = (slot + 1) & mask) {
+      uint32_t entry = _vIndex[slot];
+      if (entry == 0) return npos;
+      if (_vMembers[entry - 1].first.view() == key) return entry - 1;
+    }
+  }
+
+  // 驻留键在线性查找时只比较指针 (见 JsonKey::operator==)
+  size_t findKey(const JsonKey& key) const noexcept {
+    if (!key.isInterned() || !_vIndex.empty()) return findPos(key.view());
+    for (size_t i = 0; i < _vMembers.size(); i++) {
+      if (_vMembers[i].first == key) return i;
+    }
+    return npos;
+  }
+
+  value_type& append(JsonKey&& key, Value&& value) {
+    _vMembers.emplace_back(std::move(key), std::move(value));
+    if (!_vIndex.empty() && _vMembers.size() * 2 <= _vIndex.size()) {
+      insertIndex(_vMembers.size() - 1);
+    } else if (_vMembers.size() > INDEX_THRESHOLD) {
+      rebuildIndex();
+    }
+    return _vMembers.back();
+  }
+
+  // 槽位保存成员下标 + 1, 0 表示空; 装载率保持在 1/2 以下
+  void insertIndex(size_t pos) {
+    size_t mask = _vIndex.size() - 1;
+    size_t slot = hashKey(_vMembers[pos].first.view()) & mask;
+    while (_vIndex[slot] != 0) slot = (slot + 1) & mask;
+    _vIndex[slot] = static_cast<uint32_t>(pos + 1);
+  }
+
+  // 线性探测的后移删除: 空出的槽位之后同一探测链上的槽位依次前移,
+  // 不留墓碑. 之后 pos 后面的成员下标都减一
+  void eraseIndex(size_t pos) {
+    size_t mask = _vIndex.size() - 1;
+    size_t hole = hashKey(_vMembers[pos].first.view()) & mask;
+    while (_vIndex[hole] != pos + 1) hole = (hole + 1) & mask;
+    for (size_t slot = (hole + 1) & mask; _vIndex[slot] != 0;
+         slot = (slot + 1) & mask) {
+      size_t home = hashKey(_vMembers[_vIndex[slot] - 1].first.view()) & mask;
+      // 理想槽位不在 (hole, slot] 之间时才能前移到 hole
+      if (((slot - home) & mask) >= ((slot - hole) & mask)) {
+        _vIndex[hole] = _vIndex[slot];
+        hole = slot;
+      }
+    }
+    _vIndex[hole] = 0;
+    for (uint32_t& entry : _vIndex) {
+      if (entry > pos + 1) entry--;
+    }
+  }
+
+  void rebuildIndex() {
+    _vIndex.clear();
+    if (_vMembers.size() <= INDEX_THRESHOLD) return;
+    size_t capacity = 64;
+    while (capacity < _vMembers.size() * 4) capacity *= 2;
+    _vIndex.assign(capacity, 0);
+    for (size_t i = 0; i < _vMembers.size(); i++) insertIndex(i);
+  }
+
+  member_list _vMembers;
+  std::vector<uint32_t, ArenaAllocator<uint32_t>> _vIndex;
+};
+
 // defin jsonFiledObject
 
 class JsonFiled {
  public:
   using json_null = std::monostate;
-  using json_int = int32_t;
+  using json_int = int64_t;
+  using json_uint = uint64_t;  // 只保存超出 int64 范围的非负整数
   using json_bool = bool;
   using json_double = double;
   using json_string = std::string;
-  using json_array = std::vector<JsonFiled>;
-#if defined(__clang__)  // 如果是 Clang 编译器
-  using json_object = std::unordered_map<std::string, JsonFiled>;
-#elif defined(__GNUC__)  // 如果是 GCC 编译器
-  using json_object = std::map<std::string, JsonFiled>;
-#else                    // 对于其他编译器，如 MSVC
-  using json_object = std::unordered_map<std::string, JsonFiled>;
-#endif
-  using jsonValue = std::variant<json_null, json_int, json_bool, json_double,
-                                 json_string, json_array, json_object>;
+  using json_string_ref = std::string_view;  // 借用模式下引用输入缓冲区
+  using json_array = std::vector<JsonFiled, ArenaAllocator<JsonFiled>>;
+  using json_object = BasicJsonObject<JsonFiled>;
+  using json_member = json_object::value_type;
+  // 延迟解码模式下标量在输入中的原文 (字符串含两侧引号), 读取时才转换
+  struct json_raw {
+    std::string_view sText;
+    bool bEscaped{false};  // 字符串中是否含转义
+  };
 
  public:
-  JsonFiled() {
-    _jType = JSONTYPE::JSON_NULL;
-    _jValue = std::monostate{};
-  }
-  JsonFiled(bool b_value) {
-    _jType = JSONTYPE::JSON_BOOLEAN;
-    _jValue = b_value;
-  }
-  JsonFiled(int num) {
-    _jType = JSONTYPE::JSON_NUMBER;
-    _jValue = num;
+  JsonFiled() noexcept { _uValue.iValue = 0; }
+  JsonFiled(bool b_value) noexcept {
+    setScalar(JSONTYPE::JSON_BOOLEAN, STORAGE::BOOL);
+    _uValue.bValue = b_value;
   }
-  JsonFiled(double num) {
-    _jType = JSONTYPE::JSON_DOUBLE;
-    _jValue = num;
+  // 所有整数类型 (bool 除外): 有符号的以 int64 保存, 无符号的在 int64
+  // 范围内也以 int64 保存, 同一个数值只有一种表示
+  template <class T, std::enable_if_t<std::is_integral_v<T> &&
+                                          !std::is_same_v<T, bool>,
+                                      int> = 0>
+  JsonFiled(T num) noexcept {
+    if constexpr (std::is_signed_v<T>) {
+      setScalar(JSONTYPE::JSON_NUMBER, STORAGE::INT);
+      _uValue.iValue = static_cast<json_int>(num);
+    } else if (static_cast<json_uint>(num) <= INT64_MAX) {
+      setScalar(JSONTYPE::JSON_NUMBER, STORAGE::INT);
+      _uValue.iValue = static_cast<json_int>(num);
+    } else {
+      setScalar(JSONTYPE::JSON_NUMBER, STORAGE::UINT);
+      _uValue.uValue = static_cast<json_uint>(num);
+    }
   }
-  JsonFiled(const char* str) {
-    _jType = JSONTYPE::JSON_STRING;
-    _jValue = std::string(str);
+  JsonFiled(double num) noexcept {
+    setScalar(JSONTYPE::JSON_DOUBLE, STORAGE::DOUBLE);
+    _uValue.dValue = num;
   }
+  // 不超过 INLINE_CAPACITY 字节的字符串直接存放在节点内, 不分配内存
+  static constexpr size_t INLINE_CAPACITY = 13;
+
+  JsonFiled(const char* str) { setString(std::string_view(str)); }
   JsonFiled(std::string&& str) {
-    _jType = JSONTYPE::JSON_STRING;
-    _jValue = std::move(str);
+    if (str.size() <= INLINE_CAPACITY) {
+      setString(std::string_view(str));
+    } else {
+      _uValue.pString = new json_string(std::move(str));
+      setScalar(JSONTYPE::JSON_STRING, STORAGE::STRING);
+    }
   }
-  JsonFiled(const std::string& str) {
-    _jType = JSONTYPE::JSON_STRING;
-    _jValue = str;
+  JsonFiled(const std::string& str) { setString(std::string_view(str)); }
+  // 借用字符串: 不拷贝, 调用方保证 str 引用的字节比该值 (及其拷贝) 活得久
+  // 超过 4GB 的字符串节点中放不下长度, 退回拷贝
+  static JsonFiled borrowString(std::string_view str) {
+    if (str.size() > UINT32_MAX) return JsonFiled(json_string(str));
+    JsonFiled tField;
+    tField.setView(JSONTYPE::JSON_STRING, STORAGE::STRING_REF, str);
+    return tField;
   }
-  JsonFiled(const std::vector<JsonFiled>& value) {
-    _jType = JSONTYPE::JSON_ARRAY;
-    _jValue = value;
+  // 延迟解码的数字或字符串: 只保存输入中的原文 text, 每次读取时才转换,
+  // 序列化时原样输出; 调用方保证 text 引用的字节比该值 (及其拷贝) 活得久
+  static JsonFiled rawScalar(JSONTYPE type, std::string_view text,
+                             bool escaped = false) {
+    if (text.size() > UINT32_MAX)  // 只有字符串可能这么长
+      return JsonFiled(decodeString(json_raw{text, escaped}));
+    JsonFiled tField;
+    tField.setView(type, STORAGE::RAW, text);
+    tField._iFlags = escaped ? FLAG_ESCAPED : 0;
+    return tField;
   }
-  JsonFiled(std::vector<JsonFiled>&& value) {
-    _jType = JSONTYPE::JSON_ARRAY;
-    _jValue = std::move(value);
+  // 标记借用或延迟解码的字符串位于 arena 树中: 这样的树不逐个析构节点,
+  // 之后通过 getRef 修改该字符串时抛出异常, 而不是转为自己持有的堆上
+  // 字符串后泄漏 (见 materialize). arena 模式的解析器会设置; 拷贝不保留
+  void markArenaString() noexcept {
+    if (_eStorage == STORAGE::STRING_REF || isRawOf(JSONTYPE::JSON_STRING))
+      _iFlags |= FLAG_ARENA;
   }
-  JsonFiled(const json_object& value) {
-    _jType = JSONTYPE::JSON_OBJECT;
-    _jValue = value;
+  JsonFiled(const std::vector<JsonFiled>& value)
+      : JsonFiled(json_array(value.begin(), value.end())) {}
+  JsonFiled(const json_array& value) : JsonFiled(json_array(value)) {}
+  JsonFiled(json_array&& value) {
+    setScalar(JSONTYPE::JSON_ARRAY, STORAGE::ARRAY);
+    _uValue.pArray = box(std::move(value));
   }
+  JsonFiled(const json_object& value) : JsonFiled(json_object(value)) {}
   JsonFiled(json_object&& value) {
-    _jType = JSONTYPE::JSON_OBJECT;
-    _jValue = std::move(value);
+    setScalar(JSONTYPE::JSON_OBJECT, STORAGE::OBJECT);
+    _uValue.pObject = box(std::move(value));
   }
 
-  JsonFiled(const JsonFiled& other) {
-    _jType = other._jType;
-    _jValue = other._jValue;
+  // 拷贝时字符串、数组、对象深拷贝 (回到全局分配), 借用和原文仍然借用
+  JsonFiled(const JsonFiled& other) : JsonFiled() {
+    switch (other._eStorage) {
+      case STORAGE::STRING:
+        setString(std::string_view(*other._uValue.pString));
+        break;
+      case STORAGE::ARRAY:
+      case STORAGE::OBJECT:
+        copyContainer(other);
+        break;
+      default:
+        copyBits(other);
+        if (_eStorage != STORAGE::STRING_INLINE)
+          _iFlags = static_cast<uint8_t>(_iFlags & ~FLAG_ARENA);
+    }
   }
+  // 先拷贝再交换, other 是自身的子节点时也安全
   JsonFiled& operator=(const JsonFiled& other) {
     if (this != &other) {
-      _jType = other._jType;
-      _jValue = other._jValue;
+      JsonFiled tCopy(other);
+      swap(tCopy);
     }
     return *this;
   }
-  JsonFiled(JsonFiled&& other) {
-    _jType = other._jType;
-    _jValue = std::move(other._jValue);
+  // 移动只转移指针, 不抛异常, 容器扩容时才会移动而不是深拷贝子树
+  JsonFiled(JsonFiled&& other) noexcept {
+    copyBits(other);
+    other.copyBits(JsonFiled());
   }
-  JsonFiled& operator=(JsonFiled&& other) {
+  JsonFiled& operator=(JsonFiled&& other) noexcept {
     if (this != &other) {
-      _jType = other._jType;
-      _jValue = std::move(other._jValue);
+      JsonFiled tMoved(std::move(other));
+      swap(tMoved);
     }
     return *this;
   }
-  ~JsonFiled() = default;
+  ~JsonFiled() { destroy(); }
+
+  void swap(JsonFiled& other) noexcept {
+    JsonFiled tTemp;
+    tTemp.copyBits(*this);
+    copyBits(other);
+    other.copyBits(tTemp);
+    tTemp.copyBits(JsonFiled());
+  }
 
  public:
   // get value
+  // 类型不符时抛出 std::bad_variant_access
   template <class T>
   T get() const {
     if constexpr (std::is_same_v<T, json_null>) {
-      return std::get<json_null>(_jValue);
+      if (_eStorage != STORAGE::NONE) throw std::bad_variant_access();
+      return json_null{};
     } else if constexpr (std::is_same_v<T, json_int>) {
-      return std::get<json_int>(_jValue);
-    } else if constexpr (std::is_same_v<T, json_bool>) {
-      return std::get<json_bool>(_jValue);
+      if (isRawOf(JSONTYPE::JSON_NUMBER)) return decodeInt(raw());
+      return getRef<json_int>();
+    } else if constexpr (std::is_same_v<T, json_uint> ||
+                         std::is_same_v<T, json_bool> ||
+                         std::is_same_v<T, json_array> ||
+                         std::is_same_v<T, json_object>) {
+      return getRef<T>();
     } else if constexpr (std::is_same_v<T, json_double>) {
-      return std::get<json_double>(_jValue);
+      if (isRawOf(JSONTYPE::JSON_DOUBLE)) return decodeDouble(raw());
+      return getRef<json_double>();
     } else if constexpr (std::is_same_v<T, json_string>) {
-      return std::get<json_string>(_jValue);
-    } else if constexpr (std::is_same_v<T, json_array>) {
-      return std::get<json_array>(_jValue);
-    } else if constexpr (std::is_same_v<T, json_object>) {
-      return std::get<json_object>(_jValue);
+      if (isRawOf(JSONTYPE::JSON_STRING)) return decodeString(raw());
+      if (!isString()) throw std::bad_variant_access();
+      return json_string(stringView());
+    } else if constexpr (std::is_integral_v<T>) {  // 其他整数类型, 检查范围
+      if constexpr (std::is_signed_v<T>) {
+        json_int value = asInt();
+        if (value < std::numeric_limits<T>::min() ||
+            value > std::numeric_limits<T>::max())
+          throw std::logic_error("JSON integer out of range");
+        return static_cast<T>(value);
+      } else {
+        json_uint value = asUInt();
+        if (value > std::numeric_limits<T>::max())
+          throw std::logic_error("JSON integer out of range");
+        return static_cast<T>(value);
+      }
     } else {
       throw std::logic_error("invalid type");
     }
@@ -147,8 +830,25 @@ class JsonFiled {
   bool isObject() const noexcept { return getType() == JSONTYPE::JSON_OBJECT; }
   bool isString() const noexcept { return getType() == JSONTYPE::JSON_STRING; }
   bool isNull() const noexcept { return getType() == JSONTYPE::JSON_NULL; }
+  // 字符串值是否引用外部缓冲区 (借用/原位解析模式)
+  bool isBorrowed() const noexcept {
+    return _eStorage == STORAGE::STRING_REF;
+  }
+  // 数字或字符串是否仍以输入中的原文保存 (延迟解码模式)
+  bool isRaw() const noexcept { return _eStorage == STORAGE::RAW; }
 
-  json_int asInt() const { return static_cast<json_int>(get<json_int>()); }
+  json_int asInt() const {
+    if (_eStorage == STORAGE::UINT)
+      throw std::logic_error("JSON integer out of int64 range");
+    return get<json_int>();
+  }
+  // 非负整数按 uint64 读取
+  json_uint asUInt() const {
+    if (_eStorage == STORAGE::UINT) return _uValue.uValue;
+    json_int value = get<json_int>();
+    if (value < 0) throw std::logic_error("negative JSON integer as uint64");
+    return static_cast<json_uint>(value);
+  }
   json_double asDouble() const {
     return static_cast<json_double>(get<json_double>());
   }
@@ -162,19 +862,89 @@ class JsonFiled {
   json_object asObject() const {
     return static_cast<json_object>(get<json_object>());
   }
+
+  // 按引用访问, 不拷贝; 类型不符时抛出 std::bad_variant_access.
+  // 内联、借用或延迟解码的字符串以及延迟解码的数字没有对应的成员,
+  // 只读时请用 asStringView 或 get<T>
+  template <class T>
+  const T& getRef() const {
+    if constexpr (std::is_same_v<T, json_int>) {
+      if (_eStorage == STORAGE::INT) return _uValue.iValue;
+    } else if constexpr (std::is_same_v<T, json_uint>) {
+      if (_eStorage == STORAGE::UINT) return _uValue.uValue;
+    } else if constexpr (std::is_same_v<T, json_bool>) {
+      if (_eStorage == STORAGE::BOOL) return _uValue.bValue;
+    } else if constexpr (std::is_same_v<T, json_double>) {
+      if (_eStorage == STORAGE::DOUBLE) return _uValue.dValue;
+    } else if constexpr (std::is_same_v<T, json_string>) {
+      if (_eStorage == STORAGE::STRING) return *_uValue.pString;
+    } else if constexpr (std::is_same_v<T, json_array>) {
+      if (_eStorage == STORAGE::ARRAY) return *_uValue.pArray;
+    } else if constexpr (std::is_same_v<T, json_object>) {
+      if (_eStorage == STORAGE::OBJECT) return *_uValue.pObject;
+    } else {
+      static_assert(sizeof(T) == 0, "getRef: type is not stored in a node");
+    }
+    throw std::bad_variant_access();
+  }
+  // 可修改版本: 延迟解码的标量和内联/借用的字符串先就地转换为
+  // 自己持有的值; arena 树中的字符串不能转换, 抛出 std::logic_error
+  template <class T>
+  T& getRef() {
+    materialize();
+    return const_cast<T&>(std::as_const(*this).getRef<T>());
+  }
+  // 字符串的只读视图, 不拷贝; 视图随该值的修改或销毁而失效.
+  // 含转义的延迟解码字符串没有解码后的字节, 抛出异常, 请用 asString
+  std::string_view asStringView() const {
+    if (!isString())
+      throw std::logic_error("Cannot view as json_string, invalid type");
+    if (_eStorage == STORAGE::RAW) {
+      if (_iFlags & FLAG_ESCAPED)
+        throw std::logic_error("Escaped lazy string, use asString()");
+      return view().substr(1, _iLen - 2);
+    }
+    return stringView();
+  }
+  // 把值移出 (数组/对象/字符串不拷贝), 之后该值变为 null;
+  // 类型不符时抛出异常, 该值保持不变
   template <class T>
-  bool isMember(T&& key) const {
-    if constexpr (std::is_same_v<std::decay_t<T>, std::string> ||
-                  std::is_same_v<std::decay_t<T>, const char*> ||
-                  std::is_same_v<std::decay_t<T>, std::string_view>) {
-      if (!isObject()) return false;
-      const json_object& tObject = get<json_object>();
-      return static_cast<bool>(tObject.find(std::forward<T>(key)) !=
-                               tObject.end());
+  T take() {
+    T result = [this]() -> T {
+      if constexpr (std::is_same_v<T, json_array> ||
+                    std::is_same_v<T, json_object>) {
+        return std::move(getRef<T>());
+      } else if constexpr (std::is_same_v<T, json_string>) {
+        if (_eStorage == STORAGE::STRING) return std::move(*_uValue.pString);
+        return get<json_string>();
+      } else {
+        return get<T>();
+      }
+    }();
+    *this = JsonFiled();
+    return result;
+  }
+  // 键可以是 std::string / std::string_view / const char*, 不构造临时
+  // std::string; 其他类型返回 false
+  template <class T>
+  bool isMember(const T& key) const {
+    if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+      return find(key) != nullptr;
     } else {
       return false;
     }
   }
+  // 只读查找, 不插入也不分配内存, 可供多个线程并发读取同一棵树;
+  // 不是对象或键不存在时返回 nullptr
+  const JsonFiled* find(std::string_view sKey) const noexcept {
+    if (_eStorage != STORAGE::OBJECT) return nullptr;
+    const json_object& tObj = *_uValue.pObject;
+    auto it = tObj.find(sKey);
+    return it == tObj.end() ? nullptr : &it->second;
+  }
+  JsonFiled* find(std::string_view sKey) noexcept {
+    return const_cast<JsonFiled*>(std::as_const(*this).find(sKey));
+  }
 
   // 重载类型转换操作符
   operator int() const {
@@ -182,11 +952,17 @@ class JsonFiled {
       throw std::logic_error("Cannot convert to json_int, invalid type");
     return get<int>();
   }
-  operator std::string() const {
+  operator std::string() const& {
     if (!isString())
       throw std::logic_error("Cannot convert to json_string, invalid type");
     return get<std::string>();
   }
+  // 右值转换直接移出, 如 std::string s = std::move(root["name"])
+  operator std::string() && {
+    if (!isString())
+      throw std::logic_error("Cannot convert to json_string, invalid type");
+    return take<std::string>();
+  }
   operator double() const {
     if (!isDouble())
       throw std::logic_error("Cannot convert to json_double, invalid type");
@@ -197,25 +973,48 @@ class JsonFiled {
       throw std::logic_error("Cannot convert to json_bool, invalid type");
     return get<bool>();
   }
-  operator json_array() const {
+  operator json_array() const& {
     if (!isArray())
       throw std::logic_error("Cannot convert to json_array, invalid type");
     return get<json_array>();
   }
-  operator json_object() const {
+  operator json_array() && {
+    if (!isArray())
+      throw std::logic_error("Cannot convert to json_array, invalid type");
+    return take<json_array>();
+  }
+  operator json_object() const& {
     if (!isObject())
       throw std::logic_error("Cannot convert to json_object, invalid type");
     return get<json_object>();
   }
+  operator json_object() && {
+    if (!isObject())
+      throw std::logic_error("Cannot convert to json_object, invalid type");
+    return take<json_object>();
+  }
 
   template <typename T>
   bool operator==(const T& value) const {
     if constexpr (std::is_same_v<T, std::string>) {
-      return isString() && get<json_string>() == value;
+      return isString() && stringEquals(value);
     } else if constexpr (std::is_same_v<T, const char*>) {
-      return isString() && get<json_string>() == std::string(value);
-    } else if constexpr (std::is_same_v<T, int>) {
-      return isInt() && get<json_int>() == value;
+      return isString() && stringEquals(value);
+    } else if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool>) {
+      if (isRawOf(JSONTYPE::JSON_NUMBER))
+        return JsonFiled(decodeInt(raw())) == value;
+      const bool bInt = _eStorage == STORAGE::INT;
+      if constexpr (std::is_signed_v<T>) {
+        return bInt && _uValue.iValue == value;  // 负数不会超出 int64
+      } else {
+        if (bInt) {
+          return _uValue.iValue >= 0 &&
+                 static_cast<json_uint>(_uValue.iValue) ==
+                     static_cast<json_uint>(value);
+        }
+        return _eStorage == STORAGE::UINT &&
+               _uValue.uValue == static_cast<json_uint>(value);
+      }
     } else if constexpr (std::is_same_v<T, double>) {
       return isDouble() && get<json_double>() == value;
     } else if constexpr (std::is_same_v<T, bool>) {
@@ -233,29 +1032,35 @@ class JsonFiled {
   size_t size() const {
     if (!isArray() && !isObject())
       throw std::logic_error("Cannot get size, invalid type");
-    if (isObject()) return get<json_object>().size();
-    return get<json_array>().size();
+    if (isObject()) return _uValue.pObject->size();
+    return _uValue.pArray->size();
   }
   bool isEmpty() const {
-    if (isObject()) return get<json_object>().empty();
-    if (isArray()) return get<json_array>().empty();
+    if (isObject()) return _uValue.pObject->empty();
+    if (isArray()) return _uValue.pArray->empty();
     return false;
   }
-  JsonFiled& operator[](const std::string& sKey) {
+  // 键不存在时插入 null 值; 只读访问请用 const 版本或 find
+  JsonFiled& operator[](std::string_view sKey) {
     if(isNull()){
-      _jType = JSONTYPE::JSON_OBJECT;
-      _jValue = json_object{};
+      *this = JsonFiled(json_object{});
     }
     if (!isObject())
       throw std::logic_error("Current object is not k-v obj, invalid type");
-    json_object& tObj = std::get<json_object>(_jValue);
+    json_object& tObj = *_uValue.pObject;
     return tObj[sKey];
   }
+  JsonFiled& operator[](const std::string& sKey) {
+    return (*this)[std::string_view(sKey)];
+  }
+  JsonFiled& operator[](const char* sKey) {
+    return (*this)[std::string_view(sKey)];
+  }
 
   JsonFiled& operator[](size_t index) {
     if (!isArray())
       throw std::logic_error("Current obj is not a array, invalid index type");
-    json_array& tArray = std::get<json_array>(_jValue);
+    json_array& tArray = *_uValue.pArray;
     if (index >= tArray.size())
       throw std::logic_error("Index out of range for JSON array.");
     return tArray[index];
@@ -263,468 +1068,4312 @@ class JsonFiled {
 
   template <typename T>
   JsonFiled& operator[](T key) {
-    static_assert(std::is_same_v<T, std::string> ||
-                      std::is_same_v<T, const char*> || std::is_integral_v<T>,
+    static_assert(std::is_integral_v<T>,
                   "Unsupported key type for JsonFiled operator[]");
+    return (*this)[static_cast<size_t>(key)];  // 整数调用数组索引重载
+  }
 
-    if constexpr (std::is_integral_v<T>) {
-      return (*this)[static_cast<size_t>(key)];  // 如果是整数，调用数组索引重载
-    } else {
-      return (*this)[std::string(key)];  // 如果是字符串，调用对象键值重载
+  // 只读访问 (如 arena 中的树), 不插入, 键不存在时抛出异常
+  const JsonFiled& operator[](std::string_view sKey) const {
+    if (!isObject())
+      throw std::logic_error("Current object is not k-v obj, invalid type");
+    const JsonFiled* pValue = find(sKey);
+    if (pValue == nullptr)
+      throw std::logic_error("Key not found in JSON object.");
+    return *pValue;
+  }
+  const JsonFiled& operator[](const std::string& sKey) const {
+    return (*this)[std::string_view(sKey)];
+  }
+  const JsonFiled& operator[](const char* sKey) const {
+    return (*this)[std::string_view(sKey)];
+  }
+
+  const JsonFiled& operator[](size_t index) const {
+    if (!isArray())
+      throw std::logic_error("Current obj is not a array, invalid index type");
+    const json_array& tArray = *_uValue.pArray;
+    if (index >= tArray.size())
+      throw std::logic_error("Index out of range for JSON array.");
+    return tArray[index];
+  }
+
+  template <typename T>
+  const JsonFiled& operator[](T key) const {
+    static_assert(std::is_integral_v<T>,
+                  "Unsupported key type for JsonFiled operator[]");
+    return (*this)[static_cast<size_t>(key)];
+  }
+
+  // 该值占用的内存字节数: 节点本身加上自己持有的字符串、数组、对象
+  // (按容量计算, 含所有子节点), 不含借用的字节. 用显式栈遍历, 不随嵌套
+  // 深度递归
+  size_t memoryUsage() const {
+    size_t bytes = sizeof(JsonFiled);
+    if (!isContainerStorage()) return bytes + ownedStringBytes();
+    std::vector<const JsonFiled*> vPending{this};
+    while (!vPending.empty()) {
+      const JsonFiled* pNode = vPending.back();
+      vPending.pop_back();
+      auto visit = [&bytes, &vPending](const JsonFiled& tChild) {
+        bytes += tChild.ownedStringBytes();
+        if (tChild.isContainerStorage()) vPending.push_back(&tChild);
+      };
+      if (pNode->_eStorage == STORAGE::ARRAY) {
+        const json_array& tArray = *pNode->_uValue.pArray;
+        bytes += sizeof(json_array) + tArray.capacity() * sizeof(JsonFiled);
+        for (const JsonFiled& element : tArray) visit(element);
+      } else {
+        const json_object& tObj = *pNode->_uValue.pObject;
+        bytes += sizeof(json_object) + tObj.heapBytes() -
+                 tObj.size() * sizeof(JsonFiled);
+        for (const auto& member : tObj) {
+          bytes += member.first.heapBytes() + sizeof(JsonFiled);
+          visit(member.second);
+        }
+      }
     }
+    return bytes;
   }
 
   void push_back(JsonFiled obj) {
     if(isNull()){
-      _jType = JSONTYPE::JSON_ARRAY;
-      _jValue = json_array{};
+      *this = JsonFiled(json_array{});
     }
     if (!isArray())
       throw std::logic_error("Current object is not array, invalid type");
-    json_array& tArray = std::get<json_array>(_jValue);
+    json_array& tArray = *_uValue.pArray;
     tArray.emplace_back(JsonFiled(std::move(obj)));
   }
 
  public:
-  std::string writeToString() const {
-    switch (_jType) {
-      case JSONTYPE::JSON_NULL:
-        return "null";
-      case JSONTYPE::JSON_BOOLEAN:
-        return std::get<json_bool>(_jValue) ? "true" : "false";
-      case JSONTYPE::JSON_NUMBER:
-        return std::to_string(std::get<json_int>(_jValue));
-      case JSONTYPE::JSON_DOUBLE:
-        return std::to_string(std::get<json_double>(_jValue));
-      case JSONTYPE::JSON_STRING:
-        return "\"" + escapeString(std::get<json_string>(_jValue)) + "\"";
-      case JSONTYPE::JSON_ARRAY:
-        return arrayToString(std::get<json_array>(_jValue));
-      case JSONTYPE::JSON_OBJECT:
-        return objectToString(std::get<json_object>(_jValue));
-      default:
-        throw std::logic_error("Unknown JSON type");
-    }
-  }
+  // 紧凑输出, 见 JsonWriter
+  std::string writeToString() const;
+  // 按 options 输出, 如格式化输出
+  std::string writeToString(const JsonWriteOptions& options) const;
 
  private:
-  std::string escapeString(const std::string& str) const {
-    std::string result;
-    for (const char c : str) {
-      switch (c) {
-        case '\"':
-          result += "\\\"";
-          break;
-        case '\\':
-          result += "\\\\";
-          break;
-        case '\n':
-          result += "\\n";
-          break;
-        case '\t':
-          result += "\\t";
-          break;
-        case '\b':
-          result += "\\b";
-          break;
-        case '\f':
-          result += "\\f";
-          break;
-        case '\r':
-          result += "\\r";
-          break;
-        default:
-          if (c >= 0 && c <= 0x1F) {  // 控制字符需要转义为 \uXXXX
-            result += "\\u" + intToHex(static_cast<unsigned char>(c), 4);
-          } else {
-            result += c;
+  // 存储形式, 决定 _uValue 中哪个成员有效
+  enum class STORAGE : uint8_t {
+    NONE,        // null
+    BOOL,
+    INT,
+    UINT,        // 超出 int64 的非负整数
+    DOUBLE,
+    STRING,      // _uValue.pString 指向自己持有的 std::string
+    STRING_REF,  // _uValue.pChars + _iLen 借用外部字节
+    STRING_INLINE,  // 节点前 INLINE_CAPACITY 字节为内容, _iInlineLen 为长度
+    RAW,         // _uValue.pChars + _iLen 为延迟解码的原文
+    ARRAY,       // _uValue.pArray, 与数组元素使用同一个分配器
+    OBJECT       // _uValue.pObject, 与对象成员使用同一个分配器
+  };
+  union Payload {
+    json_int iValue;
+    json_uint uValue;
+    json_bool bValue;
+    json_double dValue;
+    const char* pChars;
+    json_string* pString;
+    json_array* pArray;
+    json_object* pObject;
+  };
+
+  void setScalar(JSONTYPE type, STORAGE storage) noexcept {
+    _jType = type;
+    _eStorage = storage;
+  }
+  void setView(JSONTYPE type, STORAGE storage, std::string_view str) noexcept {
+    setScalar(type, storage);
+    _uValue.pChars = str.data();
+    _iLen = static_cast<uint32_t>(str.size());
+  }
+  void setString(std::string_view str) {
+    if (str.size() <= INLINE_CAPACITY) {
+      if (!str.empty()) std::memcpy(inlineChars(), str.data(), str.size());
+      _iInlineLen = static_cast<uint8_t>(str.size());
+      setScalar(JSONTYPE::JSON_STRING, STORAGE::STRING_INLINE);
+    } else {
+      _uValue.pString = new json_string(str);
+      setScalar(JSONTYPE::JSON_STRING, STORAGE::STRING);
+    }
+  }
+  // 内联字符串占用 _uValue, _iLen, _iFlags 所在的前 INLINE_CAPACITY 字节
+  char* inlineChars() noexcept {
+    static_assert(offsetof(JsonFiled, _iFlags) + 1 == INLINE_CAPACITY &&
+                      offsetof(JsonFiled, _uValue) == 0,
+                  "inline string must not overlap the tags");
+    return reinterpret_cast<char*>(this);
+  }
+  const char* inlineChars() const noexcept {
+    return reinterpret_cast<const char*>(this);
+  }
+  // 按位拷贝, 不处理所有权, 由调用方保证不会重复释放
+  void copyBits(const JsonFiled& other) noexcept {
+    std::memcpy(static_cast<void*>(this), &other, sizeof(JsonFiled));
+  }
+
+  // 数组/对象本身 (32/64 字节) 放在节点之外, 用容器的分配器申请,
+  // 绑定 arena 时也位于 arena 中
+  template <class Container>
+  static Container* box(Container&& value) {
+    ArenaAllocator<Container> alloc(value.get_allocator());
+    Container* pBox = alloc.allocate(1);
+    return new (pBox) Container(std::move(value));
+  }
+  template <class Container>
+  static void unbox(Container* pBox) noexcept {
+    ArenaAllocator<Container> alloc(pBox->get_allocator());
+    pBox->~Container();
+    alloc.deallocate(pBox, 1);
+  }
+  void destroy() noexcept {
+    switch (_eStorage) {
+      case STORAGE::STRING:
+        delete _uValue.pString;
+        break;
+      case STORAGE::ARRAY:
+      case STORAGE::OBJECT:
+        destroyContainer();
+        break;
+      default:
+        break;
+    }
+  }
+  bool isContainerStorage() const noexcept {
+    return _eStorage == STORAGE::ARRAY || _eStorage == STORAGE::OBJECT;
+  }
+  static constexpr size_t MAX_TEARDOWN_DEPTH = 512;
+  // 当前线程正在析构的容器嵌套层数
+  static size_t& teardownDepth() noexcept {
+    static thread_local size_t iDepth = 0;
+    return iDepth;
+  }
+  // 容器逐层析构是递归的; 超过 MAX_TEARDOWN_DEPTH 层后改为显式栈释放,
+  // 普通深度的文档仍走原来的析构路径, 不额外分配
+  void destroyContainer() noexcept {
+    size_t& iDepth = teardownDepth();
+    if (iDepth >= MAX_TEARDOWN_DEPTH) releaseNested();
+    ++iDepth;
+    if (_eStorage == STORAGE::ARRAY) {
+      unbox(_uValue.pArray);
+    } else {
+      unbox(_uValue.pObject);
+    }
+    --iDepth;
+  }
+  // 子容器移入 vPending, 原位置留下 null
+  void detachChildren(std::vector<JsonFiled>& vPending) {
+    auto detach = [&vPending](JsonFiled& tChild) {
+      if (tChild.isContainerStorage()) vPending.push_back(std::move(tChild));
+    };
+    if (_eStorage == STORAGE::ARRAY) {
+      for (JsonFiled& tChild : *_uValue.pArray) detach(tChild);
+    } else if (_eStorage == STORAGE::OBJECT) {
+      for (auto& tMember : *_uValue.pObject) detach(tMember.second);
+    }
+  }
+  // 整棵剩余子树共用一个待释放栈, 每个节点释放时子容器都已摘走,
+  // 析构深度不再随嵌套增长. 申请栈空间失败时剩余部分退回递归析构
+  void releaseNested() noexcept {
+    std::vector<JsonFiled> vPending;
+    try {
+      detachChildren(vPending);
+      while (!vPending.empty()) {
+        JsonFiled tNode(std::move(vPending.back()));
+        vPending.pop_back();
+        tNode.detachChildren(vPending);
+      }
+    } catch (...) {
+    }
+  }
+
+  // 拷贝与析构一样逐层递归; 超过 MAX_TEARDOWN_DEPTH 层后改为显式栈拷贝
+  static size_t& copyDepth() noexcept {
+    static thread_local size_t iDepth = 0;
+    return iDepth;
+  }
+  void copyContainer(const JsonFiled& other) {
+    size_t& iDepth = copyDepth();
+    if (iDepth >= MAX_TEARDOWN_DEPTH) {
+      copyNested(other);
+      return;
+    }
+    ++iDepth;
+    try {
+      if (other._eStorage == STORAGE::ARRAY) {
+        setScalar(JSONTYPE::JSON_ARRAY, STORAGE::ARRAY);
+        _uValue.pArray = box(json_array(*other._uValue.pArray));
+      } else {
+        setScalar(JSONTYPE::JSON_OBJECT, STORAGE::OBJECT);
+        _uValue.pObject = box(json_object(*other._uValue.pObject));
+      }
+    } catch (...) {
+      --iDepth;
+      throw;
+    }
+    --iDepth;
+  }
+  // 每次只拷贝一层: 子容器先留为 null, 与源节点一起记入 vPending 稍后
+  // 填充. 容器拷贝完成后子节点的地址不再变化
+  using pending_copies = std::vector<std::pair<JsonFiled*, const JsonFiled*>>;
+  void copyNested(const JsonFiled& other) {
+    JsonFiled tRoot;
+    pending_copies vPending{{&tRoot, &other}};
+    while (!vPending.empty()) {
+      auto [pTarget, pSource] = vPending.back();
+      vPending.pop_back();
+      pTarget->copyLevel(*pSource, vPending);
+    }
+    swap(tRoot);
+  }
+  void copyLevel(const JsonFiled& other, pending_copies& vPending) {
+    auto copyChild = [](const JsonFiled& tChild) {
+      return tChild.isContainerStorage() ? JsonFiled() : JsonFiled(tChild);
+    };
+    if (other._eStorage == STORAGE::ARRAY) {
+      const json_array& tSource = *other._uValue.pArray;
+      json_array tArray;
+      tArray.reserve(tSource.size());
+      for (const JsonFiled& element : tSource)
+        tArray.push_back(copyChild(element));
+      *this = JsonFiled(std::move(tArray));
+      json_array& tTarget = *_uValue.pArray;
+      for (size_t i = 0; i < tSource.size(); i++) {
+        if (tSource[i].isContainerStorage())
+          vPending.emplace_back(&tTarget[i], &tSource[i]);
+      }
+    } else {
+      const json_object& tSource = *other._uValue.pObject;
+      json_object tObj;
+      tObj.reserve(tSource.size());
+      for (const auto& member : tSource)
+        tObj.emplace(member.first, copyChild(member.second));
+      *this = JsonFiled(std::move(tObj));
+      auto itTarget = _uValue.pObject->begin();
+      for (const auto& member : tSource) {
+        if (member.second.isContainerStorage())
+          vPending.emplace_back(&itTarget->second, &member.second);
+        ++itTarget;
+      }
+    }
+  }
+  // 自己持有的长字符串占用的堆内存, 其他存储为 0
+  size_t ownedStringBytes() const noexcept {
+    if (_eStorage != STORAGE::STRING) return 0;
+    return sizeof(json_string) + detail::stringHeapBytes(*_uValue.pString);
+  }
+
+  bool isRawOf(JSONTYPE type) const noexcept {
+    return _eStorage == STORAGE::RAW && _jType == type;
+  }
+  std::string_view view() const noexcept {
+    return std::string_view(_uValue.pChars, _iLen);
+  }
+  json_raw raw() const noexcept {
+    return json_raw{view(), (_iFlags & FLAG_ESCAPED) != 0};
+  }
+  // 原文转换, 定义在 detail 之后
+  static json_int decodeInt(const json_raw& raw);
+  static json_double decodeDouble(const json_raw& raw);
+  static json_string decodeString(const json_raw& raw);
+
+  std::string_view stringView() const {
+    if (_eStorage == STORAGE::STRING_INLINE)
+      return std::string_view(inlineChars(), _iInlineLen);
+    if (_eStorage == STORAGE::STRING_REF) return view();
+    return getRef<json_string>();
+  }
+  bool stringEquals(std::string_view value) const {
+    if (isRawOf(JSONTYPE::JSON_STRING) && (_iFlags & FLAG_ESCAPED))
+      return decodeString(raw()) == value;
+    return asStringView() == value;
+  }
+  // 延迟解码的标量和内联/借用的字符串转换为自己持有的值;
+  // arena 树中的字符串不能转换, 见 markArenaString
+  void materialize() {
+    if (isRawOf(JSONTYPE::JSON_NUMBER)) {
+      *this = JsonFiled(decodeInt(raw()));
+    } else if (isRawOf(JSONTYPE::JSON_DOUBLE)) {
+      *this = JsonFiled(decodeDouble(raw()));
+    } else if (isString() && _eStorage != STORAGE::STRING) {
+      if (_eStorage != STORAGE::STRING_INLINE && (_iFlags & FLAG_ARENA))
+        throw std::logic_error("Cannot modify a string in an arena tree");
+      JsonFiled tOwned;
+      tOwned._uValue.pString = new json_string(get<json_string>());
+      tOwned.setScalar(JSONTYPE::JSON_STRING, STORAGE::STRING);
+      swap(tOwned);
+    }
+  }
+
+
+  template <class Sink>
+  friend class JsonWriter;
+  friend std::ostream& operator<<(std::ostream& os, const JsonFiled& jsonField);
+
+ private:
+  // _iFlags 的取值, 只用于借用和延迟解码的字符串
+  static constexpr uint8_t FLAG_ESCAPED = 1;  // 原文字符串中含转义
+  static constexpr uint8_t FLAG_ARENA = 2;    // 位于 arena 树中
+
+  // 16 字节: 8 字节标量或指针 + 借用/原文的长度 + 标记
+  Payload _uValue;
+  uint32_t _iLen{0};
+  uint8_t _iFlags{0};  // FLAG_*, 内联字符串时为内容的一部分
+  STORAGE _eStorage{STORAGE::NONE};
+  jValueType _jType{JSONTYPE::JSON_NULL};
+  uint8_t _iInlineLen{0};
+};
+
+namespace detail {
+
+// 统计最低位 0 的个数, mask 不能为 0
+inline int ctz32(uint32_t mask) noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+  unsigned long idx;
+  _BitScanForward(&idx, mask);
+  return static_cast<int>(idx);
+#else
+  return __builtin_ctz(mask);
+#endif
+}
+
+inline int ctz64(uint64_t mask) noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+  unsigned long idx;
+  _BitScanForward64(&idx, mask);
+  return static_cast<int>(idx);
+#else
+  return __builtin_ctzll(mask);
+#endif
+}
+
+// 统计最高位 0 的个数, mask 不能为 0
+inline int clz64(uint64_t mask) noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+  unsigned long idx;
+  _BitScanReverse64(&idx, mask);
+  return 63 - static_cast<int>(idx);
+#else
+  return __builtin_clzll(mask);
+#endif
+}
+
+inline int popcount64(uint64_t mask) noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+  return static_cast<int>(__popcnt64(mask));
+#else
+  return __builtin_popcountll(mask);
+#endif
+}
+
+inline size_t clampPos(size_t pos, size_t len) noexcept {
+  return pos < len ? pos : len;
+}
+
+// JSON 只认 4 种空白字符 (RFC 8259), 不受 locale 影响
+inline bool isJsonSpace(char c) noexcept {
+  return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+// 从 pos 开始跳过空白, 返回第一个非空白字符的位置 (可能等于 len)
+// AVX2 每次 32 字节, SSE2 每次 16 字节, 剩余尾部走标量循环
+// readable 为 data 起可安全读取的字节数, 带填充的缓冲区 (>= len +
+// JSON_PADDING) 可以整块读取越过 len, 省掉标量尾部, 越过 len 的结果按 len 返回
+inline size_t skipWhitespace(const char* data, size_t len, size_t pos,
+                             size_t readable = 0) noexcept {
+  // 紧凑 JSON 里 token 之间通常没有空白, 先看一个字节
+  if (pos >= len || !isJsonSpace(data[pos])) return pos;
+  const size_t limit = readable > len ? readable : len;
+#if defined(YOYO_JSON_AVX2)
+  const __m256i space32 = _mm256_set1_epi8(' ');
+  const __m256i lf32 = _mm256_set1_epi8('\n');
+  const __m256i cr32 = _mm256_set1_epi8('\r');
+  const __m256i tab32 = _mm256_set1_epi8('\t');
+  while (pos + 32 <= limit) {
+    __m256i chunk =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos));
+    __m256i ws = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi8(chunk, space32),
+                        _mm256_cmpeq_epi8(chunk, lf32)),
+        _mm256_or_si256(_mm256_cmpeq_epi8(chunk, cr32),
+                        _mm256_cmpeq_epi8(chunk, tab32)));
+    uint32_t mask = ~static_cast<uint32_t>(_mm256_movemask_epi8(ws));
+    if (mask != 0) return clampPos(pos + ctz32(mask), len);
+    pos += 32;
+  }
+#endif
+#if defined(YOYO_JSON_SSE2)
+  const __m128i space16 = _mm_set1_epi8(' ');
+  const __m128i lf16 = _mm_set1_epi8('\n');
+  const __m128i cr16 = _mm_set1_epi8('\r');
+  const __m128i tab16 = _mm_set1_epi8('\t');
+  while (pos + 16 <= limit) {
+    __m128i chunk =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+    __m128i ws =
+        _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, space16),
+                                  _mm_cmpeq_epi8(chunk, lf16)),
+                     _mm_or_si128(_mm_cmpeq_epi8(chunk, cr16),
+                                  _mm_cmpeq_epi8(chunk, tab16)));
+    uint32_t mask =
+        ~static_cast<uint32_t>(_mm_movemask_epi8(ws)) & 0xFFFFu;
+    if (mask != 0) return clampPos(pos + ctz32(mask), len);
+    pos += 16;
+  }
+#endif
+  if (pos >= len) return len;
+  while (pos < len && isJsonSpace(data[pos])) pos++;
+  return pos;
+}
+
+// 从 pos 开始查找字符串中第一个需要特殊处理的字节: '"'、'\\' 或控制字符
+// (< 0x20), 返回其位置 (可能等于 len), 之前的字节可以整段拷贝
+// readable 的含义同 skipWhitespace
+inline size_t scanStringRun(const char* data, size_t len, size_t pos,
+                            size_t readable = 0) noexcept {
+  const size_t limit = readable > len ? readable : len;
+#if defined(YOYO_JSON_AVX2)
+  const __m256i quote32 = _mm256_set1_epi8('"');
+  const __m256i backslash32 = _mm256_set1_epi8('\\');
+  const __m256i ctrl32 = _mm256_set1_epi8(0x1F);
+  while (pos + 32 <= limit) {
+    __m256i chunk =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos));
+    __m256i special = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote32),
+                        _mm256_cmpeq_epi8(chunk, backslash32)),
+        _mm256_cmpeq_epi8(_mm256_max_epu8(chunk, ctrl32), ctrl32));
+    uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(special));
+    if (mask != 0) return clampPos(pos + ctz32(mask), len);
+    pos += 32;
+  }
+#endif
+#if defined(YOYO_JSON_SSE2)
+  const __m128i quote16 = _mm_set1_epi8('"');
+  const __m128i backslash16 = _mm_set1_epi8('\\');
+  const __m128i ctrl16 = _mm_set1_epi8(0x1F);
+  while (pos + 16 <= limit) {
+    __m128i chunk =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+    __m128i special =
+        _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote16),
+                                  _mm_cmpeq_epi8(chunk, backslash16)),
+                     _mm_cmpeq_epi8(_mm_max_epu8(chunk, ctrl16), ctrl16));
+    uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(special));
+    if (mask != 0) return clampPos(pos + ctz32(mask), len);
+    pos += 16;
+  }
+#endif
+  if (pos >= len) return len;
+  while (pos < len) {
+    unsigned char c = static_cast<unsigned char>(data[pos]);
+    if (c == '"' || c == '\\' || c < 0x20) break;
+    pos++;
+  }
+  return pos;
+}
+
+// 转义字符 '\\' 之后的字节对应的原字符, \\uXXXX 和不支持的转义返回 '\0'
+inline char unescapeChar(char c) noexcept {
+  switch (c) {
+    case 'n':
+      return '\n';
+    case 't':
+      return '\t';
+    case 'r':
+      return '\r';
+    case 'b':
+      return '\b';
+    case 'f':
+      return '\f';
+    case '/':
+      return '/';
+    case '"':
+      return '"';
+    case '\\':
+      return '\\';
+    default:
+      return '\0';
+  }
+}
+
+// 读取 pos 开始的 4 位十六进制数, 出错时 pos 停在不合法的字节上
+inline JSONERROR tryParseHex4(const char* data, size_t len, size_t& pos,
+                              uint32_t& value) noexcept {
+  value = 0;
+  for (int i = 0; i < 4; i++, pos++) {
+    if (pos >= len) return JSONERROR::ERROR_UNEXPECTED_END;
+    char c = data[pos];
+    uint32_t digit;
+    if (c >= '0' && c <= '9') {
+      digit = static_cast<uint32_t>(c - '0');
+    } else if ((c | 0x20) >= 'a' && (c | 0x20) <= 'f') {
+      digit = static_cast<uint32_t>((c | 0x20) - 'a' + 10);
+    } else {
+      return JSONERROR::ERROR_INVALID_STRING;
+    }
+    value = (value << 4) | digit;
+  }
+  return JSONERROR::ERROR_NONE;
+}
+
+// 码点按 UTF-8 写入 out (至多 4 字节), 返回写出的字节数
+inline size_t encodeUtf8(uint32_t code, char* out) noexcept {
+  if (code < 0x80) {
+    out[0] = static_cast<char>(code);
+    return 1;
+  }
+  if (code < 0x800) {
+    out[0] = static_cast<char>(0xC0 | (code >> 6));
+    out[1] = static_cast<char>(0x80 | (code & 0x3F));
+    return 2;
+  }
+  if (code < 0x10000) {
+    out[0] = static_cast<char>(0xE0 | (code >> 12));
+    out[1] = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+    out[2] = static_cast<char>(0x80 | (code & 0x3F));
+    return 3;
+  }
+  out[0] = static_cast<char>(0xF0 | (code >> 18));
+  out[1] = static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+  out[2] = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+  out[3] = static_cast<char>(0x80 | (code & 0x3F));
+  return 4;
+}
+
+// 解码 pos 处 ('\\' 之后) 的转义序列, UTF-8 结果写入 out (至多 4 字节),
+// n 为写出的字节数, pos 移到转义序列之后. \\uXXXX 中的代理项必须成对出现;
+// 结果不会比原文长, 可以原位解码. 出错时 pos 停在出错的字节上
+inline JSONERROR tryDecodeEscape(const char* data, size_t len, size_t& pos,
+                                 char* out, size_t& n) noexcept {
+  if (pos >= len) return JSONERROR::ERROR_UNEXPECTED_END;
+  char simple = unescapeChar(data[pos]);
+  if (simple != '\0') {
+    out[0] = simple;
+    n = 1;
+    pos++;
+    return JSONERROR::ERROR_NONE;
+  }
+  if (data[pos] != 'u') return JSONERROR::ERROR_INVALID_STRING;
+  pos++;
+  const size_t hexStart = pos;
+  uint32_t code = 0;
+  JSONERROR error = tryParseHex4(data, len, pos, code);
+  if (error != JSONERROR::ERROR_NONE) return error;
+  if (code >= 0xDC00 && code <= 0xDFFF) {  // 单独的低代理项
+    pos = hexStart;
+    return JSONERROR::ERROR_INVALID_STRING;
+  }
+  if (code >= 0xD800 && code <= 0xDBFF) {  // 高代理项后必须紧跟低代理项
+    if (pos >= len || (pos + 1 >= len && data[pos] == '\\'))
+      return JSONERROR::ERROR_UNEXPECTED_END;
+    if (data[pos] != '\\' || data[pos + 1] != 'u')
+      return JSONERROR::ERROR_INVALID_STRING;
+    pos += 2;
+    const size_t lowStart = pos;
+    uint32_t low = 0;
+    error = tryParseHex4(data, len, pos, low);
+    if (error != JSONERROR::ERROR_NONE) return error;
+    if (low < 0xDC00 || low > 0xDFFF) {
+      pos = lowStart;
+      return JSONERROR::ERROR_INVALID_STRING;
+    }
+    code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+  }
+  n = encodeUtf8(code, out);
+  return JSONERROR::ERROR_NONE;
+}
+
+// 逐字节读取已校验过的字符串原文 (不含两侧引号) 解码后的内容, 不分配内存;
+// 用于不解码整个字符串就比较或哈希含转义的键
+class DecodedReader {
+ public:
+  explicit DecodedReader(std::string_view raw) noexcept : _sRaw(raw) {}
+
+  // 读取下一个解码后的字节, 已到末尾时返回 false
+  bool next(char& c) noexcept {
+    if (_iBuffered < _iDecoded) {
+      c = _aDecoded[_iBuffered++];
+      return true;
+    }
+    if (_iPos >= _sRaw.size()) return false;
+    if (_sRaw[_iPos] != '\\') {
+      c = _sRaw[_iPos++];
+      return true;
+    }
+    _iPos++;  // 跳过 '\\', 原文已校验, 解码不会失败
+    tryDecodeEscape(_sRaw.data(), _sRaw.size(), _iPos, _aDecoded, _iDecoded);
+    _iBuffered = 1;
+    c = _aDecoded[0];
+    return true;
+  }
+
+ private:
+  std::string_view _sRaw;
+  size_t _iPos{0};
+  char _aDecoded[4];  // 当前转义序列的 UTF-8 结果
+  size_t _iDecoded{0};
+  size_t _iBuffered{0};  // _aDecoded 中已读出的字节数
+};
+
+// 前 N 个元素存放在对象内部的栈, 超出后整体搬到堆上; 只在尾部增删,
+// 元素须可平凡拷贝. 内部指针指向自身, 不可拷贝
+template <class T, size_t N>
+class SmallStack {
+ public:
+  SmallStack() noexcept = default;
+  SmallStack(const SmallStack&) = delete;
+  SmallStack& operator=(const SmallStack&) = delete;
+
+  size_t size() const noexcept { return _iSize; }
+  bool empty() const noexcept { return _iSize == 0; }
+  T& operator[](size_t i) noexcept { return _pData[i]; }
+  const T& operator[](size_t i) const noexcept { return _pData[i]; }
+  T& back() noexcept { return _pData[_iSize - 1]; }
+
+  void push_back(const T& value) {
+    reserve(_iSize + 1);
+    _pData[_iSize++] = value;
+  }
+  void pop_back() noexcept { _iSize--; }
+  // 缩小时直接丢弃尾部, 扩大时新元素为 value
+  void resize(size_t n, const T& value = T()) {
+    reserve(n);
+    for (size_t i = _iSize; i < n; i++) _pData[i] = value;
+    _iSize = n;
+  }
+
+ private:
+  void reserve(size_t n) {
+    if (n <= _iCapacity) return;
+    size_t capacity = _iCapacity * 2;
+    while (capacity < n) capacity *= 2;
+    std::vector<T> vHeap(capacity);
+    std::memcpy(vHeap.data(), _pData, _iSize * sizeof(T));
+    _vHeap.swap(vHeap);
+    _pData = _vHeap.data();
+    _iCapacity = capacity;
+  }
+
+  T _aInline[N];
+  std::vector<T> _vHeap;
+  T* _pData{_aInline};
+  size_t _iSize{0};
+  size_t _iCapacity{N};
+};
+
+// 查找第一个不合法的 UTF-8 序列, 返回其首字节位置, 全部合法时返回 len.
+// 拒绝截断的序列、多余的续字节、过长编码、代理项 (U+D800~U+DFFF) 和
+// 超过 U+10FFFF 的码点; 连续的 ASCII 每次检查 16/32 字节
+inline size_t findInvalidUtf8(const char* data, size_t len) noexcept {
+  const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+  size_t pos = 0;
+  while (pos < len) {
+#if defined(YOYO_JSON_AVX2)
+    while (pos + 32 <= len) {
+      uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos))));
+      if (mask != 0) {
+        pos += ctz32(mask);
+        break;
+      }
+      pos += 32;
+    }
+#endif
+#if defined(YOYO_JSON_SSE2)
+    while (pos + 16 <= len) {
+      uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos))));
+      if (mask != 0) {
+        pos += ctz32(mask);
+        break;
+      }
+      pos += 16;
+    }
+#endif
+    while (pos < len && bytes[pos] < 0x80) pos++;
+    if (pos >= len) break;
+    unsigned char c = bytes[pos];
+    size_t tail = 0;  // 续字节个数
+    unsigned char lo = 0x80, hi = 0xBF;  // 第二个字节的范围
+    if (c >= 0xC2 && c <= 0xDF) {
+      tail = 1;
+    } else if (c >= 0xE0 && c <= 0xEF) {
+      tail = 2;
+      if (c == 0xE0) lo = 0xA0;  // 过长编码
+      if (c == 0xED) hi = 0x9F;  // 代理项
+    } else if (c >= 0xF0 && c <= 0xF4) {
+      tail = 3;
+      if (c == 0xF0) lo = 0x90;  // 过长编码
+      if (c == 0xF4) hi = 0x8F;  // 超过 U+10FFFF
+    } else {
+      return pos;  // 单独的续字节、C0/C1 或 F5 以上
+    }
+    if (len - pos <= tail) return pos;
+    if (bytes[pos + 1] < lo || bytes[pos + 1] > hi) return pos;
+    for (size_t i = 2; i <= tail; i++) {
+      if ((bytes[pos + i] & 0xC0) != 0x80) return pos;
+    }
+    pos += tail + 1;
+  }
+  return len;
+}
+
+// SWAR: 8 个字节是否都是 '0'~'9'
+inline bool isEightDigits(uint64_t val) noexcept {
+  return ((val & 0xF0F0F0F0F0F0F0F0ULL) |
+          (((val + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) ==
+         0x3333333333333333ULL;
+}
+
+// SWAR: 8 个 ASCII 数字 (小端装入, 第一个字节为最高位) 转换为整数,
+// 相邻两位、四位、八位依次合并, 共 3 次乘法
+inline uint32_t parseEightDigits(uint64_t val) noexcept {
+  const uint64_t mask = 0x000000FF000000FFULL;
+  const uint64_t mul1 = 0x000F424000000064ULL;  // 100 + (1000000 << 32)
+  const uint64_t mul2 = 0x0000271000000001ULL;  // 1 + (10000 << 32)
+  val -= 0x3030303030303030ULL;
+  val = (val * 10) + (val >> 8);
+  val = (((val & mask) * mul1) + (((val >> 16) & mask) * mul2)) >> 32;
+  return static_cast<uint32_t>(val);
+}
+
+// 解析从 pos 开始的连续十进制数字, pos 移到数字之后, 不分配内存
+// 8 位一组用 SWAR 转换; 19 位以内一定不超出 uint64, 之后逐位检查溢出
+// 没有数字返回 ERROR_INVALID_NUMBER, 超出 uint64 返回
+// ERROR_NUMBER_OUT_OF_RANGE (pos 同样移到数字之后)
+inline JSONERROR tryParseDigits(const char* data, size_t len, size_t& pos,
+                                uint64_t& value) noexcept {
+  const size_t start = pos;
+  uint64_t result = 0;
+#if defined(YOYO_JSON_LITTLE_ENDIAN)
+  while (pos + 8 <= len && pos - start + 8 <= 19) {
+    uint64_t chunk;
+    std::memcpy(&chunk, data + pos, sizeof(chunk));
+    if (!isEightDigits(chunk)) break;
+    result = result * 100000000 + parseEightDigits(chunk);
+    pos += 8;
+  }
+#endif
+  bool overflow = false;
+  while (pos < len && data[pos] >= '0' && data[pos] <= '9') {
+    uint64_t digit = static_cast<uint64_t>(data[pos] - '0');
+    if (pos - start >= 19 && result > (UINT64_MAX - digit) / 10) {
+      overflow = true;
+    } else if (!overflow) {
+      result = result * 10 + digit;
+    }
+    pos++;
+  }
+  if (pos == start) return JSONERROR::ERROR_INVALID_NUMBER;
+  value = result;
+  return overflow ? JSONERROR::ERROR_NUMBER_OUT_OF_RANGE
+                  : JSONERROR::ERROR_NONE;
+}
+
+// 数字的整数部分: 同 tryParseDigits, 但不允许前导零 ("01" 不合法),
+// 此时 pos 停在 0 之后的数字上
+inline JSONERROR tryParseIntegerPart(const char* data, size_t len, size_t& pos,
+                                     uint64_t& value) noexcept {
+  if (pos + 1 < len && data[pos] == '0' && data[pos + 1] >= '0' &&
+      data[pos + 1] <= '9') {
+    pos++;
+    return JSONERROR::ERROR_INVALID_NUMBER;
+  }
+  return tryParseDigits(data, len, pos, value);
+}
+
+// 紧跟在整数部分之后的字节表示这是浮点数
+inline bool isFloatTail(const char* data, size_t len, size_t pos) noexcept {
+  return pos < len && (data[pos] == '.' || data[pos] == 'e' ||
+                       data[pos] == 'E');
+}
+
+// 校验从 pos 开始的数字语法并把 pos 移到数字之后, isFloat 表示是否含小数
+// 部分或指数部分; 出错时 pos 停在不合法的字节上
+inline JSONERROR tryScanNumber(const char* data, size_t len, size_t& pos,
+                               bool& isFloat) noexcept {
+  auto isDigit = [&](size_t i) {
+    return i < len && data[i] >= '0' && data[i] <= '9';
+  };
+  isFloat = false;
+  if (pos < len && data[pos] == '-') pos++;  // 跳过负号
+
+  // 整数部分, 不允许前导零
+  if (!isDigit(pos)) return JSONERROR::ERROR_INVALID_NUMBER;
+  if (data[pos] == '0' && isDigit(pos + 1)) {
+    pos++;
+    return JSONERROR::ERROR_INVALID_NUMBER;
+  }
+  while (isDigit(pos)) pos++;
+  // 小数部分, 小数点后至少一位数字
+  if (pos < len && data[pos] == '.') {
+    isFloat = true;
+    pos++;
+    if (!isDigit(pos)) return JSONERROR::ERROR_INVALID_NUMBER;
+    while (isDigit(pos)) pos++;
+  }
+  // 科学计数法部分, 指数至少一位数字
+  if (pos < len && (data[pos] == 'e' || data[pos] == 'E')) {
+    isFloat = true;
+    pos++;
+    if (pos < len && (data[pos] == '+' || data[pos] == '-')) pos++;
+    if (!isDigit(pos)) return JSONERROR::ERROR_INVALID_NUMBER;
+    while (isDigit(pos)) pos++;
+  }
+  return JSONERROR::ERROR_NONE;
+}
+
+// 抛异常版本, 返回是否为浮点数
+inline bool scanNumber(const char* data, size_t len, size_t& pos) {
+  bool isFloat = false;
+  if (tryScanNumber(data, len, pos, isFloat) != JSONERROR::ERROR_NONE) {
+    throw std::logic_error("Invalid character in number");
+  }
+  return isFloat;
+}
+
+// 10 的 0~19 次幂, 均在 uint64 范围内
+inline uint64_t powerOfTenU64(size_t exp) noexcept {
+  static constexpr uint64_t kPowers[] = {1ULL,
+                                         10ULL,
+                                         100ULL,
+                                         1000ULL,
+                                         10000ULL,
+                                         100000ULL,
+                                         1000000ULL,
+                                         10000000ULL,
+                                         100000000ULL,
+                                         1000000000ULL,
+                                         10000000000ULL,
+                                         100000000000ULL,
+                                         1000000000000ULL,
+                                         10000000000000ULL,
+                                         100000000000000ULL,
+                                         1000000000000000ULL,
+                                         10000000000000000ULL,
+                                         100000000000000000ULL,
+                                         1000000000000000000ULL,
+                                         10000000000000000000ULL};
+  return kPowers[exp];
+}
+
+// 10 的 0~22 次幂都能被 double 精确表示
+inline double powerOfTenDouble(size_t exp) noexcept {
+  static constexpr double kPowers[] = {
+      1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+      1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+  return kPowers[exp];
+}
+
+// 5^q 的 128 位近似值 (q 属于 [-342, 308]), 最高位对齐到第 127 位, 每项两个
+// uint64 (高位在前); q < 0 时向上取整, 与 Eisel-Lemire 算法的要求一致
+inline const uint64_t* powerOfFive128(int64_t q) noexcept {
+  static constexpr uint64_t kPowers[] = {
+      0xeef453d6923bd65aULL, 0x113faa2906a13b3fULL, 0x9558b4661b6565f8ULL,
+      0x4ac7ca59a424c507ULL, 0xbaaee17fa23ebf76ULL, 0x5d79bcf00d2df649ULL,
+      0xe95a99df8ace6f53ULL, 0xf4d82c2c107973dcULL, 0x91d8a02bb6c10594ULL,
+      0x79071b9b8a4be869ULL, 0xb64ec836a47146f9ULL, 0x9748e2826cdee284ULL,
+      0xe3e27a444d8d98b7ULL, 0xfd1b1b2308169b25ULL, 0x8e6d8c6ab0787f72ULL,
+      0xfe30f0f5e50e20f7ULL, 0xb208ef855c969f4fULL, 0xbdbd2d335e51a935ULL,
+      0xde8b2b66b3bc4723ULL, 0xad2c788035e61382ULL, 0x8b16fb203055ac76ULL,
+      0x4c3bcb5021afcc31ULL, 0xaddcb9e83c6b1793ULL, 0xdf4abe242a1bbf3dULL,
+      0xd953e8624b85dd78ULL, 0xd71d6dad34a2af0dULL, 0x87d4713d6f33aa6bULL,
+      0x8672648c40e5ad68ULL, 0xa9c98d8ccb009506ULL, 0x680efdaf511f18c2ULL,
+      0xd43bf0effdc0ba48ULL, 0x0212bd1b2566def2ULL, 0x84a57695fe98746dULL,
+      0x014bb630f7604b57ULL, 0xa5ced43b7e3e9188ULL, 0x419ea3bd35385e2dULL,
+      0xcf42894a5dce35eaULL, 0x52064cac828675b9ULL, 0x818995ce7aa0e1b2ULL,
+      0x7343efebd1940993ULL, 0xa1ebfb4219491a1fULL, 0x1014ebe6c5f90bf8ULL,
+      0xca66fa129f9b60a6ULL, 0xd41a26e077774ef6ULL, 0xfd00b897478238d0ULL,
+      0x8920b098955522b4ULL, 0x9e20735e8cb16382ULL, 0x55b46e5f5d5535b0ULL,
+      0xc5a890362fddbc62ULL, 0xeb2189f734aa831dULL, 0xf712b443bbd52b7bULL,
+      0xa5e9ec7501d523e4ULL, 0x9a6bb0aa55653b2dULL, 0x47b233c92125366eULL,
+      0xc1069cd4eabe89f8ULL, 0x999ec0bb696e840aULL, 0xf148440a256e2c76ULL,
+      0xc00670ea43ca250dULL, 0x96cd2a865764dbcaULL, 0x380406926a5e5728ULL,
+      0xbc807527ed3e12bcULL, 0xc605083704f5ecf2ULL, 0xeba09271e88d976bULL,
+      0xf7864a44c633682eULL, 0x93445b8731587ea3ULL, 0x7ab3ee6afbe0211dULL,
+      0xb8157268fdae9e4cULL, 0x5960ea05bad82964ULL, 0xe61acf033d1a45dfULL,
+      0x6fb92487298e33bdULL, 0x8fd0c16206306babULL, 0xa5d3b6d479f8e056ULL,
+      0xb3c4f1ba87bc8696ULL, 0x8f48a4899877186cULL, 0xe0b62e2929aba83cULL,
+      0x331acdabfe94de87ULL, 0x8c71dcd9ba0b4925ULL, 0x9ff0c08b7f1d0b14ULL,
+      0xaf8e5410288e1b6fULL, 0x07ecf0ae5ee44dd9ULL, 0xdb71e91432b1a24aULL,
+      0xc9e82cd9f69d6150ULL, 0x892731ac9faf056eULL, 0xbe311c083a225cd2ULL,
+      0xab70fe17c79ac6caULL, 0x6dbd630a48aaf406ULL, 0xd64d3d9db981787dULL,
+      0x092cbbccdad5b108ULL, 0x85f0468293f0eb4eULL, 0x25bbf56008c58ea5ULL,
+      0xa76c582338ed2621ULL, 0xaf2af2b80af6f24eULL, 0xd1476e2c07286faaULL,
+      0x1af5af660db4aee1ULL, 0x82cca4db847945caULL, 0x50d98d9fc890ed4dULL,
+      0xa37fce126597973cULL, 0xe50ff107bab528a0ULL, 0xcc5fc196fefd7d0cULL,
+      0x1e53ed49a96272c8ULL, 0xff77b1fcbebcdc4fULL, 0x25e8e89c13bb0f7aULL,
+      0x9faacf3df73609b1ULL, 0x77b191618c54e9acULL, 0xc795830d75038c1dULL,
+      0xd59df5b9ef6a2417ULL, 0xf97ae3d0d2446f25ULL, 0x4b0573286b44ad1dULL,
+      0x9becce62836ac577ULL, 0x4ee367f9430aec32ULL, 0xc2e801fb244576d5ULL,
+      0x229c41f793cda73fULL, 0xf3a20279ed56d48aULL, 0x6b43527578c1110fULL,
+      0x9845418c345644d6ULL, 0x830a13896b78aaa9ULL, 0xbe5691ef416bd60cULL,
+      0x23cc986bc656d553ULL, 0xedec366b11c6cb8fULL, 0x2cbfbe86b7ec8aa8ULL,
+      0x94b3a202eb1c3f39ULL, 0x7bf7d71432f3d6a9ULL, 0xb9e08a83a5e34f07ULL,
+      0xdaf5ccd93fb0cc53ULL, 0xe858ad248f5c22c9ULL, 0xd1b3400f8f9cff68ULL,
+      0x91376c36d99995beULL, 0x23100809b9c21fa1ULL, 0xb58547448ffffb2dULL,
+      0xabd40a0c2832a78aULL, 0xe2e69915b3fff9f9ULL, 0x16c90c8f323f516cULL,
+      0x8dd01fad907ffc3bULL, 0xae3da7d97f6792e3ULL, 0xb1442798f49ffb4aULL,
+      0x99cd11cfdf41779cULL, 0xdd95317f31c7fa1dULL, 0x40405643d711d583ULL,
+      0x8a7d3eef7f1cfc52ULL, 0x482835ea666b2572ULL, 0xad1c8eab5ee43b66ULL,
+      0xda3243650005eecfULL, 0xd863b256369d4a40ULL, 0x90bed43e40076a82ULL,
+      0x873e4f75e2224e68ULL, 0x5a7744a6e804a291ULL, 0xa90de3535aaae202ULL,
+      0x711515d0a205cb36ULL, 0xd3515c2831559a83ULL, 0x0d5a5b44ca873e03ULL,
+      0x8412d9991ed58091ULL, 0xe858790afe9486c2ULL, 0xa5178fff668ae0b6ULL,
+      0x626e974dbe39a872ULL, 0xce5d73ff402d98e3ULL, 0xfb0a3d212dc8128fULL,
+      0x80fa687f881c7f8eULL, 0x7ce66634bc9d0b99ULL, 0xa139029f6a239f72ULL,
+      0x1c1fffc1ebc44e80ULL, 0xc987434744ac874eULL, 0xa327ffb266b56220ULL,
+      0xfbe9141915d7a922ULL, 0x4bf1ff9f0062baa8ULL, 0x9d71ac8fada6c9b5ULL,
+      0x6f773fc3603db4a9ULL, 0xc4ce17b399107c22ULL, 0xcb550fb4384d21d3ULL,
+      0xf6019da07f549b2bULL, 0x7e2a53a146606a48ULL, 0x99c102844f94e0fbULL,
+      0x2eda7444cbfc426dULL, 0xc0314325637a1939ULL, 0xfa911155fefb5308ULL,
+      0xf03d93eebc589f88ULL, 0x793555ab7eba27caULL, 0x96267c7535b763b5ULL,
+      0x4bc1558b2f3458deULL, 0xbbb01b9283253ca2ULL, 0x9eb1aaedfb016f16ULL,
+      0xea9c227723ee8bcbULL, 0x465e15a979c1cadcULL, 0x92a1958a7675175fULL,
+      0x0bfacd89ec191ec9ULL, 0xb749faed14125d36ULL, 0xcef980ec671f667bULL,
+      0xe51c79a85916f484ULL, 0x82b7e12780e7401aULL, 0x8f31cc0937ae58d2ULL,
+      0xd1b2ecb8b0908810ULL, 0xb2fe3f0b8599ef07ULL, 0x861fa7e6dcb4aa15ULL,
+      0xdfbdcece67006ac9ULL, 0x67a791e093e1d49aULL, 0x8bd6a141006042bdULL,
+      0xe0c8bb2c5c6d24e0ULL, 0xaecc49914078536dULL, 0x58fae9f773886e18ULL,
+      0xda7f5bf590966848ULL, 0xaf39a475506a899eULL, 0x888f99797a5e012dULL,
+      0x6d8406c952429603ULL, 0xaab37fd7d8f58178ULL, 0xc8e5087ba6d33b83ULL,
+      0xd5605fcdcf32e1d6ULL, 0xfb1e4a9a90880a64ULL, 0x855c3be0a17fcd26ULL,
+      0x5cf2eea09a55067fULL, 0xa6b34ad8c9dfc06fULL, 0xf42faa48c0ea481eULL,
+      0xd0601d8efc57b08bULL, 0xf13b94daf124da26ULL, 0x823c12795db6ce57ULL,
+      0x76c53d08d6b70858ULL, 0xa2cb1717b52481edULL, 0x54768c4b0c64ca6eULL,
+      0xcb7ddcdda26da268ULL, 0xa9942f5dcf7dfd09ULL, 0xfe5d54150b090b02ULL,
+      0xd3f93b35435d7c4cULL, 0x9efa548d26e5a6e1ULL, 0xc47bc5014a1a6dafULL,
+      0xc6b8e9b0709f109aULL, 0x359ab6419ca1091bULL, 0xf867241c8cc6d4c0ULL,
+      0xc30163d203c94b62ULL, 0x9b407691d7fc44f8ULL, 0x79e0de63425dcf1dULL,
+      0xc21094364dfb5636ULL, 0x985915fc12f542e4ULL, 0xf294b943e17a2bc4ULL,
+      0x3e6f5b7b17b2939dULL, 0x979cf3ca6cec5b5aULL, 0xa705992ceecf9c42ULL,
+      0xbd8430bd08277231ULL, 0x50c6ff782a838353ULL, 0xece53cec4a314ebdULL,
+      0xa4f8bf5635246428ULL, 0x940f4613ae5ed136ULL, 0x871b7795e136be99ULL,
+      0xb913179899f68584ULL, 0x28e2557b59846e3fULL, 0xe757dd7ec07426e5ULL,
+      0x331aeada2fe589cfULL, 0x9096ea6f3848984fULL, 0x3ff0d2c85def7621ULL,
+      0xb4bca50b065abe63ULL, 0x0fed077a756b53a9ULL, 0xe1ebce4dc7f16dfbULL,
+      0xd3e8495912c62894ULL, 0x8d3360f09cf6e4bdULL, 0x64712dd7abbbd95cULL,
+      0xb080392cc4349decULL, 0xbd8d794d96aacfb3ULL, 0xdca04777f541c567ULL,
+      0xecf0d7a0fc5583a0ULL, 0x89e42caaf9491b60ULL, 0xf41686c49db57244ULL,
+      0xac5d37d5b79b6239ULL, 0x311c2875c522ced5ULL, 0xd77485cb25823ac7ULL,
+      0x7d633293366b828bULL, 0x86a8d39ef77164bcULL, 0xae5dff9c02033197ULL,
+      0xa8530886b54dbdebULL, 0xd9f57f830283fdfcULL, 0xd267caa862a12d66ULL,
+      0xd072df63c324fd7bULL, 0x8380dea93da4bc60ULL, 0x4247cb9e59f71e6dULL,
+      0xa46116538d0deb78ULL, 0x52d9be85f074e608ULL, 0xcd795be870516656ULL,
+      0x67902e276c921f8bULL, 0x806bd9714632dff6ULL, 0x00ba1cd8a3db53b6ULL,
+      0xa086cfcd97bf97f3ULL, 0x80e8a40eccd228a4ULL, 0xc8a883c0fdaf7df0ULL,
+      0x6122cd128006b2cdULL, 0xfad2a4b13d1b5d6cULL, 0x796b805720085f81ULL,
+      0x9cc3a6eec6311a63ULL, 0xcbe3303674053bb0ULL, 0xc3f490aa77bd60fcULL,
+      0xbedbfc4411068a9cULL, 0xf4f1b4d515acb93bULL, 0xee92fb5515482d44ULL,
+      0x991711052d8bf3c5ULL, 0x751bdd152d4d1c4aULL, 0xbf5cd54678eef0b6ULL,
+      0xd262d45a78a0635dULL, 0xef340a98172aace4ULL, 0x86fb897116c87c34ULL,
+      0x9580869f0e7aac0eULL, 0xd45d35e6ae3d4da0ULL, 0xbae0a846d2195712ULL,
+      0x8974836059cca109ULL, 0xe998d258869facd7ULL, 0x2bd1a438703fc94bULL,
+      0x91ff83775423cc06ULL, 0x7b6306a34627ddcfULL, 0xb67f6455292cbf08ULL,
+      0x1a3bc84c17b1d542ULL, 0xe41f3d6a7377eecaULL, 0x20caba5f1d9e4a93ULL,
+      0x8e938662882af53eULL, 0x547eb47b7282ee9cULL, 0xb23867fb2a35b28dULL,
+      0xe99e619a4f23aa43ULL, 0xdec681f9f4c31f31ULL, 0x6405fa00e2ec94d4ULL,
+      0x8b3c113c38f9f37eULL, 0xde83bc408dd3dd04ULL, 0xae0b158b4738705eULL,
+      0x9624ab50b148d445ULL, 0xd98ddaee19068c76ULL, 0x3badd624dd9b0957ULL,
+      0x87f8a8d4cfa417c9ULL, 0xe54ca5d70a80e5d6ULL, 0xa9f6d30a038d1dbcULL,
+      0x5e9fcf4ccd211f4cULL, 0xd47487cc8470652bULL, 0x7647c3200069671fULL,
+      0x84c8d4dfd2c63f3bULL, 0x29ecd9f40041e073ULL, 0xa5fb0a17c777cf09ULL,
+      0xf468107100525890ULL, 0xcf79cc9db955c2ccULL, 0x7182148d4066eeb4ULL,
+      0x81ac1fe293d599bfULL, 0xc6f14cd848405530ULL, 0xa21727db38cb002fULL,
+      0xb8ada00e5a506a7cULL, 0xca9cf1d206fdc03bULL, 0xa6d90811f0e4851cULL,
+      0xfd442e4688bd304aULL, 0x908f4a166d1da663ULL, 0x9e4a9cec15763e2eULL,
+      0x9a598e4e043287feULL, 0xc5dd44271ad3cdbaULL, 0x40eff1e1853f29fdULL,
+      0xf7549530e188c128ULL, 0xd12bee59e68ef47cULL, 0x9a94dd3e8cf578b9ULL,
+      0x82bb74f8301958ceULL, 0xc13a148e3032d6e7ULL, 0xe36a52363c1faf01ULL,
+      0xf18899b1bc3f8ca1ULL, 0xdc44e6c3cb279ac1ULL, 0x96f5600f15a7b7e5ULL,
+      0x29ab103a5ef8c0b9ULL, 0xbcb2b812db11a5deULL, 0x7415d448f6b6f0e7ULL,
+      0xebdf661791d60f56ULL, 0x111b495b3464ad21ULL, 0x936b9fcebb25c995ULL,
+      0xcab10dd900beec34ULL, 0xb84687c269ef3bfbULL, 0x3d5d514f40eea742ULL,
+      0xe65829b3046b0afaULL, 0x0cb4a5a3112a5112ULL, 0x8ff71a0fe2c2e6dcULL,
+      0x47f0e785eaba72abULL, 0xb3f4e093db73a093ULL, 0x59ed216765690f56ULL,
+      0xe0f218b8d25088b8ULL, 0x306869c13ec3532cULL, 0x8c974f7383725573ULL,
+      0x1e414218c73a13fbULL, 0xafbd2350644eeacfULL, 0xe5d1929ef90898faULL,
+      0xdbac6c247d62a583ULL, 0xdf45f746b74abf39ULL, 0x894bc396ce5da772ULL,
+      0x6b8bba8c328eb783ULL, 0xab9eb47c81f5114fULL, 0x066ea92f3f326564ULL,
+      0xd686619ba27255a2ULL, 0xc80a537b0efefebdULL, 0x8613fd0145877585ULL,
+      0xbd06742ce95f5f36ULL, 0xa798fc4196e952e7ULL, 0x2c48113823b73704ULL,
+      0xd17f3b51fca3a7a0ULL, 0xf75a15862ca504c5ULL, 0x82ef85133de648c4ULL,
+      0x9a984d73dbe722fbULL, 0xa3ab66580d5fdaf5ULL, 0xc13e60d0d2e0ebbaULL,
+      0xcc963fee10b7d1b3ULL, 0x318df905079926a8ULL, 0xffbbcfe994e5c61fULL,
+      0xfdf17746497f7052ULL, 0x9fd561f1fd0f9bd3ULL, 0xfeb6ea8bedefa633ULL,
+      0xc7caba6e7c5382c8ULL, 0xfe64a52ee96b8fc0ULL, 0xf9bd690a1b68637bULL,
+      0x3dfdce7aa3c673b0ULL, 0x9c1661a651213e2dULL, 0x06bea10ca65c084eULL,
+      0xc31bfa0fe5698db8ULL, 0x486e494fcff30a62ULL, 0xf3e2f893dec3f126ULL,
+      0x5a89dba3c3efccfaULL, 0x986ddb5c6b3a76b7ULL, 0xf89629465a75e01cULL,
+      0xbe89523386091465ULL, 0xf6bbb397f1135823ULL, 0xee2ba6c0678b597fULL,
+      0x746aa07ded582e2cULL, 0x94db483840b717efULL, 0xa8c2a44eb4571cdcULL,
+      0xba121a4650e4ddebULL, 0x92f34d62616ce413ULL, 0xe896a0d7e51e1566ULL,
+      0x77b020baf9c81d17ULL, 0x915e2486ef32cd60ULL, 0x0ace1474dc1d122eULL,
+      0xb5b5ada8aaff80b8ULL, 0x0d819992132456baULL, 0xe3231912d5bf60e6ULL,
+      0x10e1fff697ed6c69ULL, 0x8df5efabc5979c8fULL, 0xca8d3ffa1ef463c1ULL,
+      0xb1736b96b6fd83b3ULL, 0xbd308ff8a6b17cb2ULL, 0xddd0467c64bce4a0ULL,
+      0xac7cb3f6d05ddbdeULL, 0x8aa22c0dbef60ee4ULL, 0x6bcdf07a423aa96bULL,
+      0xad4ab7112eb3929dULL, 0x86c16c98d2c953c6ULL, 0xd89d64d57a607744ULL,
+      0xe871c7bf077ba8b7ULL, 0x87625f056c7c4a8bULL, 0x11471cd764ad4972ULL,
+      0xa93af6c6c79b5d2dULL, 0xd598e40d3dd89bcfULL, 0xd389b47879823479ULL,
+      0x4aff1d108d4ec2c3ULL, 0x843610cb4bf160cbULL, 0xcedf722a585139baULL,
+      0xa54394fe1eedb8feULL, 0xc2974eb4ee658828ULL, 0xce947a3da6a9273eULL,
+      0x733d226229feea32ULL, 0x811ccc668829b887ULL, 0x0806357d5a3f525fULL,
+      0xa163ff802a3426a8ULL, 0xca07c2dcb0cf26f7ULL, 0xc9bcff6034c13052ULL,
+      0xfc89b393dd02f0b5ULL, 0xfc2c3f3841f17c67ULL, 0xbbac2078d443ace2ULL,
+      0x9d9ba7832936edc0ULL, 0xd54b944b84aa4c0dULL, 0xc5029163f384a931ULL,
+      0x0a9e795e65d4df11ULL, 0xf64335bcf065d37dULL, 0x4d4617b5ff4a16d5ULL,
+      0x99ea0196163fa42eULL, 0x504bced1bf8e4e45ULL, 0xc06481fb9bcf8d39ULL,
+      0xe45ec2862f71e1d6ULL, 0xf07da27a82c37088ULL, 0x5d767327bb4e5a4cULL,
+      0x964e858c91ba2655ULL, 0x3a6a07f8d510f86fULL, 0xbbe226efb628afeaULL,
+      0x890489f70a55368bULL, 0xeadab0aba3b2dbe5ULL, 0x2b45ac74ccea842eULL,
+      0x92c8ae6b464fc96fULL, 0x3b0b8bc90012929dULL, 0xb77ada0617e3bbcbULL,
+      0x09ce6ebb40173744ULL, 0xe55990879ddcaabdULL, 0xcc420a6a101d0515ULL,
+      0x8f57fa54c2a9eab6ULL, 0x9fa946824a12232dULL, 0xb32df8e9f3546564ULL,
+      0x47939822dc96abf9ULL, 0xdff9772470297ebdULL, 0x59787e2b93bc56f7ULL,
+      0x8bfbea76c619ef36ULL, 0x57eb4edb3c55b65aULL, 0xaefae51477a06b03ULL,
+      0xede622920b6b23f1ULL, 0xdab99e59958885c4ULL, 0xe95fab368e45ecedULL,
+      0x88b402f7fd75539bULL, 0x11dbcb0218ebb414ULL, 0xaae103b5fcd2a881ULL,
+      0xd652bdc29f26a119ULL, 0xd59944a37c0752a2ULL, 0x4be76d3346f0495fULL,
+      0x857fcae62d8493a5ULL, 0x6f70a4400c562ddbULL, 0xa6dfbd9fb8e5b88eULL,
+      0xcb4ccd500f6bb952ULL, 0xd097ad07a71f26b2ULL, 0x7e2000a41346a7a7ULL,
+      0x825ecc24c873782fULL, 0x8ed400668c0c28c8ULL, 0xa2f67f2dfa90563bULL,
+      0x728900802f0f32faULL, 0xcbb41ef979346bcaULL, 0x4f2b40a03ad2ffb9ULL,
+      0xfea126b7d78186bcULL, 0xe2f610c84987bfa8ULL, 0x9f24b832e6b0f436ULL,
+      0x0dd9ca7d2df4d7c9ULL, 0xc6ede63fa05d3143ULL, 0x91503d1c79720dbbULL,
+      0xf8a95fcf88747d94ULL, 0x75a44c6397ce912aULL, 0x9b69dbe1b548ce7cULL,
+      0xc986afbe3ee11abaULL, 0xc24452da229b021bULL, 0xfbe85badce996168ULL,
+      0xf2d56790ab41c2a2ULL, 0xfae27299423fb9c3ULL, 0x97c560ba6b0919a5ULL,
+      0xdccd879fc967d41aULL, 0xbdb6b8e905cb600fULL, 0x5400e987bbc1c920ULL,
+      0xed246723473e3813ULL, 0x290123e9aab23b68ULL, 0x9436c0760c86e30bULL,
+      0xf9a0b6720aaf6521ULL, 0xb94470938fa89bceULL, 0xf808e40e8d5b3e69ULL,
+      0xe7958cb87392c2c2ULL, 0xb60b1d1230b20e04ULL, 0x90bd77f3483bb9b9ULL,
+      0xb1c6f22b5e6f48c2ULL, 0xb4ecd5f01a4aa828ULL, 0x1e38aeb6360b1af3ULL,
+      0xe2280b6c20dd5232ULL, 0x25c6da63c38de1b0ULL, 0x8d590723948a535fULL,
+      0x579c487e5a38ad0eULL, 0xb0af48ec79ace837ULL, 0x2d835a9df0c6d851ULL,
+      0xdcdb1b2798182244ULL, 0xf8e431456cf88e65ULL, 0x8a08f0f8bf0f156bULL,
+      0x1b8e9ecb641b58ffULL, 0xac8b2d36eed2dac5ULL, 0xe272467e3d222f3fULL,
+      0xd7adf884aa879177ULL, 0x5b0ed81dcc6abb0fULL, 0x86ccbb52ea94baeaULL,
+      0x98e947129fc2b4e9ULL, 0xa87fea27a539e9a5ULL, 0x3f2398d747b36224ULL,
+      0xd29fe4b18e88640eULL, 0x8eec7f0d19a03aadULL, 0x83a3eeeef9153e89ULL,
+      0x1953cf68300424acULL, 0xa48ceaaab75a8e2bULL, 0x5fa8c3423c052dd7ULL,
+      0xcdb02555653131b6ULL, 0x3792f412cb06794dULL, 0x808e17555f3ebf11ULL,
+      0xe2bbd88bbee40bd0ULL, 0xa0b19d2ab70e6ed6ULL, 0x5b6aceaeae9d0ec4ULL,
+      0xc8de047564d20a8bULL, 0xf245825a5a445275ULL, 0xfb158592be068d2eULL,
+      0xeed6e2f0f0d56712ULL, 0x9ced737bb6c4183dULL, 0x55464dd69685606bULL,
+      0xc428d05aa4751e4cULL, 0xaa97e14c3c26b886ULL, 0xf53304714d9265dfULL,
+      0xd53dd99f4b3066a8ULL, 0x993fe2c6d07b7fabULL, 0xe546a8038efe4029ULL,
+      0xbf8fdb78849a5f96ULL, 0xde98520472bdd033ULL, 0xef73d256a5c0f77cULL,
+      0x963e66858f6d4440ULL, 0x95a8637627989aadULL, 0xdde7001379a44aa8ULL,
+      0xbb127c53b17ec159ULL, 0x5560c018580d5d52ULL, 0xe9d71b689dde71afULL,
+      0xaab8f01e6e10b4a6ULL, 0x9226712162ab070dULL, 0xcab3961304ca70e8ULL,
+      0xb6b00d69bb55c8d1ULL, 0x3d607b97c5fd0d22ULL, 0xe45c10c42a2b3b05ULL,
+      0x8cb89a7db77c506aULL, 0x8eb98a7a9a5b04e3ULL, 0x77f3608e92adb242ULL,
+      0xb267ed1940f1c61cULL, 0x55f038b237591ed3ULL, 0xdf01e85f912e37a3ULL,
+      0x6b6c46dec52f6688ULL, 0x8b61313bbabce2c6ULL, 0x2323ac4b3b3da015ULL,
+      0xae397d8aa96c1b77ULL, 0xabec975e0a0d081aULL, 0xd9c7dced53c72255ULL,
+      0x96e7bd358c904a21ULL, 0x881cea14545c7575ULL, 0x7e50d64177da2e54ULL,
+      0xaa242499697392d2ULL, 0xdde50bd1d5d0b9e9ULL, 0xd4ad2dbfc3d07787ULL,
+      0x955e4ec64b44e864ULL, 0x84ec3c97da624ab4ULL, 0xbd5af13bef0b113eULL,
+      0xa6274bbdd0fadd61ULL, 0xecb1ad8aeacdd58eULL, 0xcfb11ead453994baULL,
+      0x67de18eda5814af2ULL, 0x81ceb32c4b43fcf4ULL, 0x80eacf948770ced7ULL,
+      0xa2425ff75e14fc31ULL, 0xa1258379a94d028dULL, 0xcad2f7f5359a3b3eULL,
+      0x096ee45813a04330ULL, 0xfd87b5f28300ca0dULL, 0x8bca9d6e188853fcULL,
+      0x9e74d1b791e07e48ULL, 0x775ea264cf55347eULL, 0xc612062576589ddaULL,
+      0x95364afe032a819eULL, 0xf79687aed3eec551ULL, 0x3a83ddbd83f52205ULL,
+      0x9abe14cd44753b52ULL, 0xc4926a9672793543ULL, 0xc16d9a0095928a27ULL,
+      0x75b7053c0f178294ULL, 0xf1c90080baf72cb1ULL, 0x5324c68b12dd6339ULL,
+      0x971da05074da7beeULL, 0xd3f6fc16ebca5e04ULL, 0xbce5086492111aeaULL,
+      0x88f4bb1ca6bcf585ULL, 0xec1e4a7db69561a5ULL, 0x2b31e9e3d06c32e6ULL,
+      0x9392ee8e921d5d07ULL, 0x3aff322e62439fd0ULL, 0xb877aa3236a4b449ULL,
+      0x09befeb9fad487c3ULL, 0xe69594bec44de15bULL, 0x4c2ebe687989a9b4ULL,
+      0x901d7cf73ab0acd9ULL, 0x0f9d37014bf60a11ULL, 0xb424dc35095cd80fULL,
+      0x538484c19ef38c95ULL, 0xe12e13424bb40e13ULL, 0x2865a5f206b06fbaULL,
+      0x8cbccc096f5088cbULL, 0xf93f87b7442e45d4ULL, 0xafebff0bcb24aafeULL,
+      0xf78f69a51539d749ULL, 0xdbe6fecebdedd5beULL, 0xb573440e5a884d1cULL,
+      0x89705f4136b4a597ULL, 0x31680a88f8953031ULL, 0xabcc77118461cefcULL,
+      0xfdc20d2b36ba7c3eULL, 0xd6bf94d5e57a42bcULL, 0x3d32907604691b4dULL,
+      0x8637bd05af6c69b5ULL, 0xa63f9a49c2c1b110ULL, 0xa7c5ac471b478423ULL,
+      0x0fcf80dc33721d54ULL, 0xd1b71758e219652bULL, 0xd3c36113404ea4a9ULL,
+      0x83126e978d4fdf3bULL, 0x645a1cac083126eaULL, 0xa3d70a3d70a3d70aULL,
+      0x3d70a3d70a3d70a4ULL, 0xccccccccccccccccULL, 0xcccccccccccccccdULL,
+      0x8000000000000000ULL, 0x0000000000000000ULL, 0xa000000000000000ULL,
+      0x0000000000000000ULL, 0xc800000000000000ULL, 0x0000000000000000ULL,
+      0xfa00000000000000ULL, 0x0000000000000000ULL, 0x9c40000000000000ULL,
+      0x0000000000000000ULL, 0xc350000000000000ULL, 0x0000000000000000ULL,
+      0xf424000000000000ULL, 0x0000000000000000ULL, 0x9896800000000000ULL,
+      0x0000000000000000ULL, 0xbebc200000000000ULL, 0x0000000000000000ULL,
+      0xee6b280000000000ULL, 0x0000000000000000ULL, 0x9502f90000000000ULL,
+      0x0000000000000000ULL, 0xba43b74000000000ULL, 0x0000000000000000ULL,
+      0xe8d4a51000000000ULL, 0x0000000000000000ULL, 0x9184e72a00000000ULL,
+      0x0000000000000000ULL, 0xb5e620f480000000ULL, 0x0000000000000000ULL,
+      0xe35fa931a0000000ULL, 0x0000000000000000ULL, 0x8e1bc9bf04000000ULL,
+      0x0000000000000000ULL, 0xb1a2bc2ec5000000ULL, 0x0000000000000000ULL,
+      0xde0b6b3a76400000ULL, 0x0000000000000000ULL, 0x8ac7230489e80000ULL,
+      0x0000000000000000ULL, 0xad78ebc5ac620000ULL, 0x0000000000000000ULL,
+      0xd8d726b7177a8000ULL, 0x0000000000000000ULL, 0x878678326eac9000ULL,
+      0x0000000000000000ULL, 0xa968163f0a57b400ULL, 0x0000000000000000ULL,
+      0xd3c21bcecceda100ULL, 0x0000000000000000ULL, 0x84595161401484a0ULL,
+      0x0000000000000000ULL, 0xa56fa5b99019a5c8ULL, 0x0000000000000000ULL,
+      0xcecb8f27f4200f3aULL, 0x0000000000000000ULL, 0x813f3978f8940984ULL,
+      0x4000000000000000ULL, 0xa18f07d736b90be5ULL, 0x5000000000000000ULL,
+      0xc9f2c9cd04674edeULL, 0xa400000000000000ULL, 0xfc6f7c4045812296ULL,
+      0x4d00000000000000ULL, 0x9dc5ada82b70b59dULL, 0xf020000000000000ULL,
+      0xc5371912364ce305ULL, 0x6c28000000000000ULL, 0xf684df56c3e01bc6ULL,
+      0xc732000000000000ULL, 0x9a130b963a6c115cULL, 0x3c7f400000000000ULL,
+      0xc097ce7bc90715b3ULL, 0x4b9f100000000000ULL, 0xf0bdc21abb48db20ULL,
+      0x1e86d40000000000ULL, 0x96769950b50d88f4ULL, 0x1314448000000000ULL,
+      0xbc143fa4e250eb31ULL, 0x17d955a000000000ULL, 0xeb194f8e1ae525fdULL,
+      0x5dcfab0800000000ULL, 0x92efd1b8d0cf37beULL, 0x5aa1cae500000000ULL,
+      0xb7abc627050305adULL, 0xf14a3d9e40000000ULL, 0xe596b7b0c643c719ULL,
+      0x6d9ccd05d0000000ULL, 0x8f7e32ce7bea5c6fULL, 0xe4820023a2000000ULL,
+      0xb35dbf821ae4f38bULL, 0xdda2802c8a800000ULL, 0xe0352f62a19e306eULL,
+      0xd50b2037ad200000ULL, 0x8c213d9da502de45ULL, 0x4526f422cc340000ULL,
+      0xaf298d050e4395d6ULL, 0x9670b12b7f410000ULL, 0xdaf3f04651d47b4cULL,
+      0x3c0cdd765f114000ULL, 0x88d8762bf324cd0fULL, 0xa5880a69fb6ac800ULL,
+      0xab0e93b6efee0053ULL, 0x8eea0d047a457a00ULL, 0xd5d238a4abe98068ULL,
+      0x72a4904598d6d880ULL, 0x85a36366eb71f041ULL, 0x47a6da2b7f864750ULL,
+      0xa70c3c40a64e6c51ULL, 0x999090b65f67d924ULL, 0xd0cf4b50cfe20765ULL,
+      0xfff4b4e3f741cf6dULL, 0x82818f1281ed449fULL, 0xbff8f10e7a8921a4ULL,
+      0xa321f2d7226895c7ULL, 0xaff72d52192b6a0dULL, 0xcbea6f8ceb02bb39ULL,
+      0x9bf4f8a69f764490ULL, 0xfee50b7025c36a08ULL, 0x02f236d04753d5b4ULL,
+      0x9f4f2726179a2245ULL, 0x01d762422c946590ULL, 0xc722f0ef9d80aad6ULL,
+      0x424d3ad2b7b97ef5ULL, 0xf8ebad2b84e0d58bULL, 0xd2e0898765a7deb2ULL,
+      0x9b934c3b330c8577ULL, 0x63cc55f49f88eb2fULL, 0xc2781f49ffcfa6d5ULL,
+      0x3cbf6b71c76b25fbULL, 0xf316271c7fc3908aULL, 0x8bef464e3945ef7aULL,
+      0x97edd871cfda3a56ULL, 0x97758bf0e3cbb5acULL, 0xbde94e8e43d0c8ecULL,
+      0x3d52eeed1cbea317ULL, 0xed63a231d4c4fb27ULL, 0x4ca7aaa863ee4bddULL,
+      0x945e455f24fb1cf8ULL, 0x8fe8caa93e74ef6aULL, 0xb975d6b6ee39e436ULL,
+      0xb3e2fd538e122b44ULL, 0xe7d34c64a9c85d44ULL, 0x60dbbca87196b616ULL,
+      0x90e40fbeea1d3a4aULL, 0xbc8955e946fe31cdULL, 0xb51d13aea4a488ddULL,
+      0x6babab6398bdbe41ULL, 0xe264589a4dcdab14ULL, 0xc696963c7eed2dd1ULL,
+      0x8d7eb76070a08aecULL, 0xfc1e1de5cf543ca2ULL, 0xb0de65388cc8ada8ULL,
+      0x3b25a55f43294bcbULL, 0xdd15fe86affad912ULL, 0x49ef0eb713f39ebeULL,
+      0x8a2dbf142dfcc7abULL, 0x6e3569326c784337ULL, 0xacb92ed9397bf996ULL,
+      0x49c2c37f07965404ULL, 0xd7e77a8f87daf7fbULL, 0xdc33745ec97be906ULL,
+      0x86f0ac99b4e8dafdULL, 0x69a028bb3ded71a3ULL, 0xa8acd7c0222311bcULL,
+      0xc40832ea0d68ce0cULL, 0xd2d80db02aabd62bULL, 0xf50a3fa490c30190ULL,
+      0x83c7088e1aab65dbULL, 0x792667c6da79e0faULL, 0xa4b8cab1a1563f52ULL,
+      0x577001b891185938ULL, 0xcde6fd5e09abcf26ULL, 0xed4c0226b55e6f86ULL,
+      0x80b05e5ac60b6178ULL, 0x544f8158315b05b4ULL, 0xa0dc75f1778e39d6ULL,
+      0x696361ae3db1c721ULL, 0xc913936dd571c84cULL, 0x03bc3a19cd1e38e9ULL,
+      0xfb5878494ace3a5fULL, 0x04ab48a04065c723ULL, 0x9d174b2dcec0e47bULL,
+      0x62eb0d64283f9c76ULL, 0xc45d1df942711d9aULL, 0x3ba5d0bd324f8394ULL,
+      0xf5746577930d6500ULL, 0xca8f44ec7ee36479ULL, 0x9968bf6abbe85f20ULL,
+      0x7e998b13cf4e1ecbULL, 0xbfc2ef456ae276e8ULL, 0x9e3fedd8c321a67eULL,
+      0xefb3ab16c59b14a2ULL, 0xc5cfe94ef3ea101eULL, 0x95d04aee3b80ece5ULL,
+      0xbba1f1d158724a12ULL, 0xbb445da9ca61281fULL, 0x2a8a6e45ae8edc97ULL,
+      0xea1575143cf97226ULL, 0xf52d09d71a3293bdULL, 0x924d692ca61be758ULL,
+      0x593c2626705f9c56ULL, 0xb6e0c377cfa2e12eULL, 0x6f8b2fb00c77836cULL,
+      0xe498f455c38b997aULL, 0x0b6dfb9c0f956447ULL, 0x8edf98b59a373fecULL,
+      0x4724bd4189bd5eacULL, 0xb2977ee300c50fe7ULL, 0x58edec91ec2cb657ULL,
+      0xdf3d5e9bc0f653e1ULL, 0x2f2967b66737e3edULL, 0x8b865b215899f46cULL,
+      0xbd79e0d20082ee74ULL, 0xae67f1e9aec07187ULL, 0xecd8590680a3aa11ULL,
+      0xda01ee641a708de9ULL, 0xe80e6f4820cc9495ULL, 0x884134fe908658b2ULL,
+      0x3109058d147fdcddULL, 0xaa51823e34a7eedeULL, 0xbd4b46f0599fd415ULL,
+      0xd4e5e2cdc1d1ea96ULL, 0x6c9e18ac7007c91aULL, 0x850fadc09923329eULL,
+      0x03e2cf6bc604ddb0ULL, 0xa6539930bf6bff45ULL, 0x84db8346b786151cULL,
+      0xcfe87f7cef46ff16ULL, 0xe612641865679a63ULL, 0x81f14fae158c5f6eULL,
+      0x4fcb7e8f3f60c07eULL, 0xa26da3999aef7749ULL, 0xe3be5e330f38f09dULL,
+      0xcb090c8001ab551cULL, 0x5cadf5bfd3072cc5ULL, 0xfdcb4fa002162a63ULL,
+      0x73d9732fc7c8f7f6ULL, 0x9e9f11c4014dda7eULL, 0x2867e7fddcdd9afaULL,
+      0xc646d63501a1511dULL, 0xb281e1fd541501b8ULL, 0xf7d88bc24209a565ULL,
+      0x1f225a7ca91a4226ULL, 0x9ae757596946075fULL, 0x3375788de9b06958ULL,
+      0xc1a12d2fc3978937ULL, 0x0052d6b1641c83aeULL, 0xf209787bb47d6b84ULL,
+      0xc0678c5dbd23a49aULL, 0x9745eb4d50ce6332ULL, 0xf840b7ba963646e0ULL,
+      0xbd176620a501fbffULL, 0xb650e5a93bc3d898ULL, 0xec5d3fa8ce427affULL,
+      0xa3e51f138ab4cebeULL, 0x93ba47c980e98cdfULL, 0xc66f336c36b10137ULL,
+      0xb8a8d9bbe123f017ULL, 0xb80b0047445d4184ULL, 0xe6d3102ad96cec1dULL,
+      0xa60dc059157491e5ULL, 0x9043ea1ac7e41392ULL, 0x87c89837ad68db2fULL,
+      0xb454e4a179dd1877ULL, 0x29babe4598c311fbULL, 0xe16a1dc9d8545e94ULL,
+      0xf4296dd6fef3d67aULL, 0x8ce2529e2734bb1dULL, 0x1899e4a65f58660cULL,
+      0xb01ae745b101e9e4ULL, 0x5ec05dcff72e7f8fULL, 0xdc21a1171d42645dULL,
+      0x76707543f4fa1f73ULL, 0x899504ae72497ebaULL, 0x6a06494a791c53a8ULL,
+      0xabfa45da0edbde69ULL, 0x0487db9d17636892ULL, 0xd6f8d7509292d603ULL,
+      0x45a9d2845d3c42b6ULL, 0x865b86925b9bc5c2ULL, 0x0b8a2392ba45a9b2ULL,
+      0xa7f26836f282b732ULL, 0x8e6cac7768d7141eULL, 0xd1ef0244af2364ffULL,
+      0x3207d795430cd926ULL, 0x8335616aed761f1fULL, 0x7f44e6bd49e807b8ULL,
+      0xa402b9c5a8d3a6e7ULL, 0x5f16206c9c6209a6ULL, 0xcd036837130890a1ULL,
+      0x36dba887c37a8c0fULL, 0x802221226be55a64ULL, 0xc2494954da2c9789ULL,
+      0xa02aa96b06deb0fdULL, 0xf2db9baa10b7bd6cULL, 0xc83553c5c8965d3dULL,
+      0x6f92829494e5acc7ULL, 0xfa42a8b73abbf48cULL, 0xcb772339ba1f17f9ULL,
+      0x9c69a97284b578d7ULL, 0xff2a760414536efbULL, 0xc38413cf25e2d70dULL,
+      0xfef5138519684abaULL, 0xf46518c2ef5b8cd1ULL, 0x7eb258665fc25d69ULL,
+      0x98bf2f79d5993802ULL, 0xef2f773ffbd97a61ULL, 0xbeeefb584aff8603ULL,
+      0xaafb550ffacfd8faULL, 0xeeaaba2e5dbf6784ULL, 0x95ba2a53f983cf38ULL,
+      0x952ab45cfa97a0b2ULL, 0xdd945a747bf26183ULL, 0xba756174393d88dfULL,
+      0x94f971119aeef9e4ULL, 0xe912b9d1478ceb17ULL, 0x7a37cd5601aab85dULL,
+      0x91abb422ccb812eeULL, 0xac62e055c10ab33aULL, 0xb616a12b7fe617aaULL,
+      0x577b986b314d6009ULL, 0xe39c49765fdf9d94ULL, 0xed5a7e85fda0b80bULL,
+      0x8e41ade9fbebc27dULL, 0x14588f13be847307ULL, 0xb1d219647ae6b31cULL,
+      0x596eb2d8ae258fc8ULL, 0xde469fbd99a05fe3ULL, 0x6fca5f8ed9aef3bbULL,
+      0x8aec23d680043beeULL, 0x25de7bb9480d5854ULL, 0xada72ccc20054ae9ULL,
+      0xaf561aa79a10ae6aULL, 0xd910f7ff28069da4ULL, 0x1b2ba1518094da04ULL,
+      0x87aa9aff79042286ULL, 0x90fb44d2f05d0842ULL, 0xa99541bf57452b28ULL,
+      0x353a1607ac744a53ULL, 0xd3fa922f2d1675f2ULL, 0x42889b8997915ce8ULL,
+      0x847c9b5d7c2e09b7ULL, 0x69956135febada11ULL, 0xa59bc234db398c25ULL,
+      0x43fab9837e699095ULL, 0xcf02b2c21207ef2eULL, 0x94f967e45e03f4bbULL,
+      0x8161afb94b44f57dULL, 0x1d1be0eebac278f5ULL, 0xa1ba1ba79e1632dcULL,
+      0x6462d92a69731732ULL, 0xca28a291859bbf93ULL, 0x7d7b8f7503cfdcfeULL,
+      0xfcb2cb35e702af78ULL, 0x5cda735244c3d43eULL, 0x9defbf01b061adabULL,
+      0x3a0888136afa64a7ULL, 0xc56baec21c7a1916ULL, 0x088aaa1845b8fdd0ULL,
+      0xf6c69a72a3989f5bULL, 0x8aad549e57273d45ULL, 0x9a3c2087a63f6399ULL,
+      0x36ac54e2f678864bULL, 0xc0cb28a98fcf3c7fULL, 0x84576a1bb416a7ddULL,
+      0xf0fdf2d3f3c30b9fULL, 0x656d44a2a11c51d5ULL, 0x969eb7c47859e743ULL,
+      0x9f644ae5a4b1b325ULL, 0xbc4665b596706114ULL, 0x873d5d9f0dde1feeULL,
+      0xeb57ff22fc0c7959ULL, 0xa90cb506d155a7eaULL, 0x9316ff75dd87cbd8ULL,
+      0x09a7f12442d588f2ULL, 0xb7dcbf5354e9beceULL, 0x0c11ed6d538aeb2fULL,
+      0xe5d3ef282a242e81ULL, 0x8f1668c8a86da5faULL, 0x8fa475791a569d10ULL,
+      0xf96e017d694487bcULL, 0xb38d92d760ec4455ULL, 0x37c981dcc395a9acULL,
+      0xe070f78d3927556aULL, 0x85bbe253f47b1417ULL, 0x8c469ab843b89562ULL,
+      0x93956d7478ccec8eULL, 0xaf58416654a6babbULL, 0x387ac8d1970027b2ULL,
+      0xdb2e51bfe9d0696aULL, 0x06997b05fcc0319eULL, 0x88fcf317f22241e2ULL,
+      0x441fece3bdf81f03ULL, 0xab3c2fddeeaad25aULL, 0xd527e81cad7626c3ULL,
+      0xd60b3bd56a5586f1ULL, 0x8a71e223d8d3b074ULL, 0x85c7056562757456ULL,
+      0xf6872d5667844e49ULL, 0xa738c6bebb12d16cULL, 0xb428f8ac016561dbULL,
+      0xd106f86e69d785c7ULL, 0xe13336d701beba52ULL, 0x82a45b450226b39cULL,
+      0xecc0024661173473ULL, 0xa34d721642b06084ULL, 0x27f002d7f95d0190ULL,
+      0xcc20ce9bd35c78a5ULL, 0x31ec038df7b441f4ULL, 0xff290242c83396ceULL,
+      0x7e67047175a15271ULL, 0x9f79a169bd203e41ULL, 0x0f0062c6e984d386ULL,
+      0xc75809c42c684dd1ULL, 0x52c07b78a3e60868ULL, 0xf92e0c3537826145ULL,
+      0xa7709a56ccdf8a82ULL, 0x9bbcc7a142b17ccbULL, 0x88a66076400bb691ULL,
+      0xc2abf989935ddbfeULL, 0x6acff893d00ea435ULL, 0xf356f7ebf83552feULL,
+      0x0583f6b8c4124d43ULL, 0x98165af37b2153deULL, 0xc3727a337a8b704aULL,
+      0xbe1bf1b059e9a8d6ULL, 0x744f18c0592e4c5cULL, 0xeda2ee1c7064130cULL,
+      0x1162def06f79df73ULL, 0x9485d4d1c63e8be7ULL, 0x8addcb5645ac2ba8ULL,
+      0xb9a74a0637ce2ee1ULL, 0x6d953e2bd7173692ULL, 0xe8111c87c5c1ba99ULL,
+      0xc8fa8db6ccdd0437ULL, 0x910ab1d4db9914a0ULL, 0x1d9c9892400a22a2ULL,
+      0xb54d5e4a127f59c8ULL, 0x2503beb6d00cab4bULL, 0xe2a0b5dc971f303aULL,
+      0x2e44ae64840fd61dULL, 0x8da471a9de737e24ULL, 0x5ceaecfed289e5d2ULL,
+      0xb10d8e1456105dadULL, 0x7425a83e872c5f47ULL, 0xdd50f1996b947518ULL,
+      0xd12f124e28f77719ULL, 0x8a5296ffe33cc92fULL, 0x82bd6b70d99aaa6fULL,
+      0xace73cbfdc0bfb7bULL, 0x636cc64d1001550bULL, 0xd8210befd30efa5aULL,
+      0x3c47f7e05401aa4eULL, 0x8714a775e3e95c78ULL, 0x65acfaec34810a71ULL,
+      0xa8d9d1535ce3b396ULL, 0x7f1839a741a14d0dULL, 0xd31045a8341ca07cULL,
+      0x1ede48111209a050ULL, 0x83ea2b892091e44dULL, 0x934aed0aab460432ULL,
+      0xa4e4b66b68b65d60ULL, 0xf81da84d5617853fULL, 0xce1de40642e3f4b9ULL,
+      0x36251260ab9d668eULL, 0x80d2ae83e9ce78f3ULL, 0xc1d72b7c6b426019ULL,
+      0xa1075a24e4421730ULL, 0xb24cf65b8612f81fULL, 0xc94930ae1d529cfcULL,
+      0xdee033f26797b627ULL, 0xfb9b7cd9a4a7443cULL, 0x169840ef017da3b1ULL,
+      0x9d412e0806e88aa5ULL, 0x8e1f289560ee864eULL, 0xc491798a08a2ad4eULL,
+      0xf1a6f2bab92a27e2ULL, 0xf5b5d7ec8acb58a2ULL, 0xae10af696774b1dbULL,
+      0x9991a6f3d6bf1765ULL, 0xacca6da1e0a8ef29ULL, 0xbff610b0cc6edd3fULL,
+      0x17fd090a58d32af3ULL, 0xeff394dcff8a948eULL, 0xddfc4b4cef07f5b0ULL,
+      0x95f83d0a1fb69cd9ULL, 0x4abdaf101564f98eULL, 0xbb764c4ca7a4440fULL,
+      0x9d6d1ad41abe37f1ULL, 0xea53df5fd18d5513ULL, 0x84c86189216dc5edULL,
+      0x92746b9be2f8552cULL, 0x32fd3cf5b4e49bb4ULL, 0xb7118682dbb66a77ULL,
+      0x3fbc8c33221dc2a1ULL, 0xe4d5e82392a40515ULL, 0x0fabaf3feaa5334aULL,
+      0x8f05b1163ba6832dULL, 0x29cb4d87f2a7400eULL, 0xb2c71d5bca9023f8ULL,
+      0x743e20e9ef511012ULL, 0xdf78e4b2bd342cf6ULL, 0x914da9246b255416ULL,
+      0x8bab8eefb6409c1aULL, 0x1ad089b6c2f7548eULL, 0xae9672aba3d0c320ULL,
+      0xa184ac2473b529b1ULL, 0xda3c0f568cc4f3e8ULL, 0xc9e5d72d90a2741eULL,
+      0x8865899617fb1871ULL, 0x7e2fa67c7a658892ULL, 0xaa7eebfb9df9de8dULL,
+      0xddbb901b98feeab7ULL, 0xd51ea6fa85785631ULL, 0x552a74227f3ea565ULL,
+      0x8533285c936b35deULL, 0xd53a88958f87275fULL, 0xa67ff273b8460356ULL,
+      0x8a892abaf368f137ULL, 0xd01fef10a657842cULL, 0x2d2b7569b0432d85ULL,
+      0x8213f56a67f6b29bULL, 0x9c3b29620e29fc73ULL, 0xa298f2c501f45f42ULL,
+      0x8349f3ba91b47b8fULL, 0xcb3f2f7642717713ULL, 0x241c70a936219a73ULL,
+      0xfe0efb53d30dd4d7ULL, 0xed238cd383aa0110ULL, 0x9ec95d1463e8a506ULL,
+      0xf4363804324a40aaULL, 0xc67bb4597ce2ce48ULL, 0xb143c6053edcd0d5ULL,
+      0xf81aa16fdc1b81daULL, 0xdd94b7868e94050aULL, 0x9b10a4e5e9913128ULL,
+      0xca7cf2b4191c8326ULL, 0xc1d4ce1f63f57d72ULL, 0xfd1c2f611f63a3f0ULL,
+      0xf24a01a73cf2dccfULL, 0xbc633b39673c8cecULL, 0x976e41088617ca01ULL,
+      0xd5be0503e085d813ULL, 0xbd49d14aa79dbc82ULL, 0x4b2d8644d8a74e18ULL,
+      0xec9c459d51852ba2ULL, 0xddf8e7d60ed1219eULL, 0x93e1ab8252f33b45ULL,
+      0xcabb90e5c942b503ULL, 0xb8da1662e7b00a17ULL, 0x3d6a751f3b936243ULL,
+      0xe7109bfba19c0c9dULL, 0x0cc512670a783ad4ULL, 0x906a617d450187e2ULL,
+      0x27fb2b80668b24c5ULL, 0xb484f9dc9641e9daULL, 0xb1f9f660802dedf6ULL,
+      0xe1a63853bbd26451ULL, 0x5e7873f8a0396973ULL, 0x8d07e33455637eb2ULL,
+      0xdb0b487b6423e1e8ULL, 0xb049dc016abc5e5fULL, 0x91ce1a9a3d2cda62ULL,
+      0xdc5c5301c56b75f7ULL, 0x7641a140cc7810fbULL, 0x89b9b3e11b6329baULL,
+      0xa9e904c87fcb0a9dULL, 0xac2820d9623bf429ULL, 0x546345fa9fbdcd44ULL,
+      0xd732290fbacaf133ULL, 0xa97c177947ad4095ULL, 0x867f59a9d4bed6c0ULL,
+      0x49ed8eabcccc485dULL, 0xa81f301449ee8c70ULL, 0x5c68f256bfff5a74ULL,
+      0xd226fc195c6a2f8cULL, 0x73832eec6fff3111ULL, 0x83585d8fd9c25db7ULL,
+      0xc831fd53c5ff7eabULL, 0xa42e74f3d032f525ULL, 0xba3e7ca8b77f5e55ULL,
+      0xcd3a1230c43fb26fULL, 0x28ce1bd2e55f35ebULL, 0x80444b5e7aa7cf85ULL,
+      0x7980d163cf5b81b3ULL, 0xa0555e361951c366ULL, 0xd7e105bcc332621fULL,
+      0xc86ab5c39fa63440ULL, 0x8dd9472bf3fefaa7ULL, 0xfa856334878fc150ULL,
+      0xb14f98f6f0feb951ULL, 0x9c935e00d4b9d8d2ULL, 0x6ed1bf9a569f33d3ULL,
+      0xc3b8358109e84f07ULL, 0x0a862f80ec4700c8ULL, 0xf4a642e14c6262c8ULL,
+      0xcd27bb612758c0faULL, 0x98e7e9cccfbd7dbdULL, 0x8038d51cb897789cULL,
+      0xbf21e44003acdd2cULL, 0xe0470a63e6bd56c3ULL, 0xeeea5d5004981478ULL,
+      0x1858ccfce06cac74ULL, 0x95527a5202df0ccbULL, 0x0f37801e0c43ebc8ULL,
+      0xbaa718e68396cffdULL, 0xd30560258f54e6baULL, 0xe950df20247c83fdULL,
+      0x47c6b82ef32a2069ULL, 0x91d28b7416cdd27eULL, 0x4cdc331d57fa5441ULL,
+      0xb6472e511c81471dULL, 0xe0133fe4adf8e952ULL, 0xe3d8f9e563a198e5ULL,
+      0x58180fddd97723a6ULL, 0x8e679c2f5e44ff8fULL, 0x570f09eaa7ea7648ULL
+  };
+  return kPowers + 2 * (q + 342);
+}
+
+struct UInt128 {
+  uint64_t low;
+  uint64_t high;
+};
+
+// 64 x 64 位乘法的完整 128 位结果
+inline UInt128 fullMultiply(uint64_t a, uint64_t b) noexcept {
+#if defined(__SIZEOF_INT128__)
+  unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+  return {static_cast<uint64_t>(product), static_cast<uint64_t>(product >> 64)};
+#elif defined(_MSC_VER) && defined(_M_X64)
+  UInt128 result;
+  result.low = _umul128(a, b, &result.high);
+  return result;
+#else
+  uint64_t aLow = a & 0xFFFFFFFF, aHigh = a >> 32;
+  uint64_t bLow = b & 0xFFFFFFFF, bHigh = b >> 32;
+  uint64_t lowLow = aLow * bLow;
+  uint64_t highLow = aHigh * bLow;
+  uint64_t cross = (lowLow >> 32) + (highLow & 0xFFFFFFFF) + aLow * bHigh;
+  return {(cross << 32) | (lowLow & 0xFFFFFFFF),
+          aHigh * bHigh + (highLow >> 32) + (cross >> 32)};
+#endif
+}
+
+// Eisel-Lemire: w * 10^q (w 非零且不超过 19 位) 与 5^q 的 128 位近似值相乘,
+// 取乘积高位直接得到正确舍入的 double, 不需要大整数运算. 无法确定舍入方向,
+// 或结果为非规格化数/溢出时返回 false, 由调用方交给慢速路径
+inline bool eiselLemire(uint64_t w, int64_t q, bool negative,
+                        double& value) noexcept {
+  if (q < -342 || q > 308) return false;
+  const int lz = clz64(w);
+  w <<= lz;
+  const uint64_t* power = powerOfFive128(q);
+  UInt128 product = fullMultiply(w, power[0]);
+  // 高 64 位中舍弃的低 9 位全为 1 时, 低位乘积的进位可能影响结果
+  const uint64_t kPrecisionMask = UINT64_MAX >> 55;
+  if ((product.high & kPrecisionMask) == kPrecisionMask) {
+    UInt128 second = fullMultiply(w, power[1]);
+    product.low += second.high;
+    if (second.high > product.low) product.high++;
+    if (product.low == UINT64_MAX && (q < -27 || q > 55)) return false;
+  }
+  const int upperBit = static_cast<int>(product.high >> 63);
+  const int shift = upperBit + 64 - 52 - 3;
+  uint64_t mantissa = product.high >> shift;
+  // floor(log2(10^q)) + 63 换算为带偏移的二进制指数
+  int64_t power2 = ((217706 * q) >> 16) + 63 + upperBit - lz + 1023;
+  if (power2 <= 0) return false;
+  // 恰好落在两个 double 中间时按偶数舍入
+  if (product.low <= 1 && q >= -4 && q <= 23 && (mantissa & 3) == 1 &&
+      (mantissa << shift) == product.high) {
+    mantissa &= ~uint64_t{1};
+  }
+  mantissa += mantissa & 1;
+  mantissa >>= 1;
+  if (mantissa >= (uint64_t{2} << 52)) {  // 舍入后进位
+    mantissa = uint64_t{1} << 52;
+    power2++;
+  }
+  if (power2 >= 0x7FF) return false;
+  uint64_t bits = (mantissa & ~(uint64_t{1} << 52)) |
+                  (static_cast<uint64_t>(power2) << 52) |
+                  (static_cast<uint64_t>(negative) << 63);
+  std::memcpy(&value, &bits, sizeof(value));
+  return true;
+}
+
+// std::from_chars 报告超出范围时按数量级区分上溢 (±inf) 和下溢 (±0),
+// [first, last) 已经过语法校验
+inline double outOfRangeValue(const char* first, const char* last) noexcept {
+  bool negative = *first == '-';
+  if (negative) first++;
+  int64_t magnitude = 0;  // 首个非零数字相对小数点的位置
+  while (first < last && *first == '0') first++;
+  while (first < last && *first >= '0' && *first <= '9') {
+    magnitude++;
+    first++;
+  }
+  if (first < last && *first == '.') {
+    first++;
+    if (magnitude == 0) {
+      while (first < last && *first == '0') {
+        magnitude--;
+        first++;
+      }
+    }
+    while (first < last && *first >= '0' && *first <= '9') first++;
+  }
+  int64_t exponent = 0;
+  if (first < last) {  // 'e' 或 'E'
+    first++;
+    bool expNegative = *first == '-';
+    if (*first == '+' || *first == '-') first++;
+    for (; first < last; first++) {
+      if (exponent < 1000000) exponent = exponent * 10 + (*first - '0');
+    }
+    if (expNegative) exponent = -exponent;
+  }
+  double result = magnitude + exponent > 0
+                      ? std::numeric_limits<double>::infinity()
+                      : 0.0;
+  return negative ? -result : result;
+}
+
+// 把从 pos 开始的数字转换为最接近的 double, 直接读取输入字节, 不分配内存,
+// 也不受 locale 影响. 有效数字用 SWAR 解析, 依次尝试:
+// 1. Clinger: 有效数字不超过 2^53 且十进制指数在 [-22, 22] 内时两者都是
+//    精确值, 一次乘除法的 IEEE 舍入就是正确结果
+// 2. Eisel-Lemire: 有效数字不超过 19 位的其余情况
+// 3. std::from_chars: 同样保证正确舍入, 处理剩下的少数情况
+// 语法错误时 pos 停在不合法的字节上, 超出 double 范围返回
+// ERROR_NUMBER_OUT_OF_RANGE
+inline JSONERROR tryParseDouble(const char* data, size_t len, size_t& pos,
+                                double& value) noexcept {
+  const size_t start = pos;
+  bool negative = pos < len && data[pos] == '-';
+  if (negative) pos++;
+
+  // 整数部分
+  const size_t intStart = pos;
+  uint64_t mantissa = 0;
+  JSONERROR code = tryParseIntegerPart(data, len, pos, mantissa);
+  if (code == JSONERROR::ERROR_INVALID_NUMBER) return code;
+  bool fast = code == JSONERROR::ERROR_NONE;  // 有效数字能精确放入 uint64
+  const size_t digits = pos - intStart;
+  int64_t exp10 = 0;
+
+  // 小数部分, 与整数部分合并为一个有效数字
+  if (pos < len && data[pos] == '.') {
+    pos++;
+    const size_t fracStart = pos;
+    uint64_t fraction = 0;
+    code = tryParseDigits(data, len, pos, fraction);
+    if (code == JSONERROR::ERROR_INVALID_NUMBER) return code;
+    const size_t fracDigits = pos - fracStart;
+    if (code != JSONERROR::ERROR_NONE) {
+      fast = false;
+    } else if (mantissa == 0) {  // 整数部分为 0 时小数的前导零不占有效位数
+      mantissa = fraction;
+    } else if (digits + fracDigits <= 19) {
+      mantissa = mantissa * powerOfTenU64(fracDigits) + fraction;
+    } else {
+      fast = false;
+    }
+    exp10 = -static_cast<int64_t>(fracDigits);
+  }
+
+  // 科学计数法部分
+  if (pos < len && (data[pos] == 'e' || data[pos] == 'E')) {
+    pos++;
+    bool expNegative = false;
+    if (pos < len && (data[pos] == '+' || data[pos] == '-')) {
+      expNegative = data[pos] == '-';
+      pos++;
+    }
+    uint64_t exponent = 0;
+    code = tryParseDigits(data, len, pos, exponent);
+    if (code == JSONERROR::ERROR_INVALID_NUMBER) return code;
+    if (code != JSONERROR::ERROR_NONE || exponent > 100000) {
+      fast = false;
+    } else {
+      exp10 += expNegative ? -static_cast<int64_t>(exponent)
+                           : static_cast<int64_t>(exponent);
+    }
+  }
+
+  if (fast && mantissa == 0) {
+    value = negative ? -0.0 : 0.0;
+    return JSONERROR::ERROR_NONE;
+  }
+#if !defined(FLT_EVAL_METHOD) || FLT_EVAL_METHOD == 0
+  // x87 扩展精度下中间结果会二次舍入, 只在按 double 精度计算的平台走快速路径
+  const uint64_t kMaxExact = 1ULL << 53;
+  if (fast && mantissa <= kMaxExact) {
+    // 指数略大于 22 时先把多出的部分乘进有效数字, 仍不超过 2^53 时依旧精确
+    if (exp10 > 22 && exp10 <= 22 + 15) {
+      uint64_t scale = powerOfTenU64(static_cast<size_t>(exp10 - 22));
+      if (mantissa <= kMaxExact / scale) {
+        mantissa *= scale;
+        exp10 = 22;
+      }
+    }
+    if (exp10 >= -22 && exp10 <= 22) {
+      double result = static_cast<double>(mantissa);
+      if (exp10 < 0) {
+        result /= powerOfTenDouble(static_cast<size_t>(-exp10));
+      } else {
+        result *= powerOfTenDouble(static_cast<size_t>(exp10));
+      }
+      value = negative ? -result : result;
+      return JSONERROR::ERROR_NONE;
+    }
+  }
+#endif
+  if (fast && eiselLemire(mantissa, exp10, negative, value)) {
+    return JSONERROR::ERROR_NONE;
+  }
+
+  // 慢速路径: 超过 19 位有效数字, 非规格化数或超出范围
+  auto res = std::from_chars(data + start, data + pos, value);
+  if (res.ec != std::errc()) {
+    value = outOfRangeValue(data + start, data + pos);
+    return JSONERROR::ERROR_NUMBER_OUT_OF_RANGE;
+  }
+  return JSONERROR::ERROR_NONE;
+}
+
+// 抛异常版本, 与 strtod 一致, 超出范围时返回 ±inf 或 ±0 而不报错
+inline double parseDouble(const char* data, size_t len, size_t& pos) {
+  double value = 0;
+  JSONERROR code = tryParseDouble(data, len, pos, value);
+  if (code != JSONERROR::ERROR_NONE &&
+      code != JSONERROR::ERROR_NUMBER_OUT_OF_RANGE) {
+    throw std::logic_error("Invalid character in number");
+  }
+  return value;
+}
+
+// 输出一个数字最多需要的字节数 (最长的 double 为 24 字节, 另留 ".0")
+inline constexpr size_t NUMBER_BUFFER_SIZE = 32;
+
+// "00" "01" ... "99", 每次除以 100 输出两位数字
+inline const char* digitPairs() noexcept {
+  static constexpr char kPairs[] =
+      "0001020304050607080910111213141516171819"
+      "2021222324252627282930313233343536373839"
+      "4041424344454647484950515253545556575859"
+      "6061626364656667686970717273747576777879"
+      "8081828384858687888990919293949596979899";
+  return kPairs;
+}
+
+inline int countDigits(uint64_t value) noexcept {
+  int digits = 1;
+  while (true) {
+    if (value < 10) return digits;
+    if (value < 100) return digits + 1;
+    if (value < 1000) return digits + 2;
+    if (value < 10000) return digits + 3;
+    value /= 10000;
+    digits += 4;
+  }
+}
+
+// 把整数写到 out, 返回写入结束的位置; 不分配内存, 不受 locale 影响
+inline char* writeUInt(char* out, uint64_t value) noexcept {
+  const char* pairs = digitPairs();
+  char* end = out + countDigits(value);
+  char* pos = end;  // 先算出位数, 从低位向前填充
+  while (value >= 100) {
+    pos -= 2;
+    std::memcpy(pos, pairs + (value % 100) * 2, 2);
+    value /= 100;
+  }
+  if (value >= 10) {
+    std::memcpy(pos - 2, pairs + value * 2, 2);
+  } else {
+    pos[-1] = static_cast<char>('0' + value);
+  }
+  return end;
+}
+
+inline char* writeInt(char* out, int64_t value) noexcept {
+  uint64_t magnitude = static_cast<uint64_t>(value);
+  if (value < 0) {
+    *out++ = '-';
+    magnitude = 0 - magnitude;
+  }
+  return writeUInt(out, magnitude);
+}
+
+// 以最短的往返格式 (解析回来得到同一个 double) 写到 out, out 至少有
+// NUMBER_BUFFER_SIZE 字节. 没有小数点和指数时补 ".0", 再次解析仍是浮点数;
+// JSON 不能表示 NaN 和 Inf, 输出 null
+inline char* writeDouble(char* out, double value) noexcept {
+  if (!std::isfinite(value)) {
+    std::memcpy(out, "null", 4);
+    return out + 4;
+  }
+  char* end = std::to_chars(out, out + NUMBER_BUFFER_SIZE, value).ptr;
+  for (char* pos = out; pos < end; ++pos) {
+    if (*pos == '.' || *pos == 'e') return end;
+  }
+  std::memcpy(end, ".0", 2);
+  return end + 2;
+}
+
+// 输出时需要转义的字节 ('"'、'\\' 和控制字符) 对应的转义序列, 查表代替
+// 逐字符 switch 和 iostream 格式化; 控制字符有短格式时优先用短格式
+inline std::string_view escapeSequence(unsigned char c) noexcept {
+  static constexpr char kControl[32][7] = {
+      "\\u0000", "\\u0001", "\\u0002", "\\u0003", "\\u0004", "\\u0005",
+      "\\u0006", "\\u0007", "\\b", "\\t", "\\n", "\\u000b",
+      "\\f", "\\r", "\\u000e", "\\u000f", "\\u0010", "\\u0011",
+      "\\u0012", "\\u0013", "\\u0014", "\\u0015", "\\u0016", "\\u0017",
+      "\\u0018", "\\u0019", "\\u001a", "\\u001b", "\\u001c", "\\u001d",
+      "\\u001e", "\\u001f"};
+  if (c == '"') return "\\\"";
+  if (c == '\\') return "\\\\";
+  return std::string_view(kControl[c], kControl[c][1] == 'u' ? 6 : 2);
+}
+
+// 解码 pos 处 (指向起始引号) 的字符串并追加到 out, pos 移到结束引号之后
+// 无需转义的内容按段整体拷贝; 出错时 pos 停在出错的字节上
+inline JSONERROR tryAppendString(const char* data, size_t len, size_t& pos,
+                                 std::string& out, size_t readable = 0) {
+  pos++;  // 跳过起始引号 '"'
+  size_t runEnd = scanStringRun(data, len, pos, readable);
+  while (true) {
+    out.append(data + pos, runEnd - pos);  // 整段拷贝无需转义的内容
+    pos = runEnd;
+    if (pos >= len) return JSONERROR::ERROR_UNEXPECTED_END;
+    char c = data[pos];
+    if (c == '"') break;
+    if (c != '\\') return JSONERROR::ERROR_INVALID_STRING;  // 控制字符
+    pos++;  // 检测转义字符
+    char decoded[4];
+    size_t n = 0;
+    JSONERROR code = tryDecodeEscape(data, len, pos, decoded, n);
+    if (code != JSONERROR::ERROR_NONE) return code;
+    out.append(decoded, n);
+    runEnd = scanStringRun(data, len, pos, readable);
+  }
+  pos++;  // 跳过最后的引号 '"'
+  return JSONERROR::ERROR_NONE;
+}
+
+// 抛异常版本
+inline void appendString(const char* data, size_t len, size_t& pos,
+                         std::string& out, size_t readable = 0) {
+  if (tryAppendString(data, len, pos, out, readable) !=
+      JSONERROR::ERROR_NONE) {
+    throw std::logic_error("invalid or unterminated string in JSON");
+  }
+}
+
+// 原位解码 pos 处 (指向起始引号) 的字符串: 解码结果不会比原文长, 直接写回
+// 起始引号之后的位置, view 为解码后内容, pos 移到结束引号之后
+inline JSONERROR tryUnescapeInPlace(char* data, size_t len, size_t& pos,
+                                    std::string_view& view,
+                                    size_t readable = 0) {
+  pos++;  // 跳过起始引号 '"'
+  char* begin = data + pos;
+  char* out = begin;
+  size_t runEnd = scanStringRun(data, len, pos, readable);
+  while (true) {
+    size_t runLen = runEnd - pos;
+    if (out != data + pos) std::memmove(out, data + pos, runLen);
+    out += runLen;
+    pos = runEnd;
+    if (pos >= len) return JSONERROR::ERROR_UNEXPECTED_END;
+    char c = data[pos];
+    if (c == '"') break;
+    if (c != '\\') return JSONERROR::ERROR_INVALID_STRING;  // 控制字符
+    pos++;  // 检测转义字符
+    char decoded[4];
+    size_t n = 0;
+    JSONERROR code = tryDecodeEscape(data, len, pos, decoded, n);
+    if (code != JSONERROR::ERROR_NONE) return code;
+    std::memcpy(out, decoded, n);
+    out += n;
+    runEnd = scanStringRun(data, len, pos, readable);
+  }
+  pos++;  // 跳过最后的引号 '"'
+  view = std::string_view(begin, static_cast<size_t>(out - begin));
+  return JSONERROR::ERROR_NONE;
+}
+
+// 校验 pos 处 (指向起始引号) 的字符串, 并在解码的同时与 key 逐段比较,
+// 不分配内存; match 为解码结果是否等于 key, pos 移到结束引号之后
+inline JSONERROR tryMatchString(const char* data, size_t len, size_t& pos,
+                                std::string_view key, bool& match) noexcept {
+  pos++;  // 跳过起始引号 '"'
+  size_t matched = 0;  // key 中已比较过的字节数
+  match = true;
+  auto compare = [&](const char* bytes, size_t n) {
+    if (!match) return;
+    match = n <= key.size() - matched &&
+            (n == 0 || std::memcmp(key.data() + matched, bytes, n) == 0);
+    matched += n;
+  };
+  size_t runEnd = scanStringRun(data, len, pos);
+  while (true) {
+    compare(data + pos, runEnd - pos);
+    pos = runEnd;
+    if (pos >= len) return JSONERROR::ERROR_UNEXPECTED_END;
+    char c = data[pos];
+    if (c == '"') break;
+    if (c != '\\') return JSONERROR::ERROR_INVALID_STRING;  // 控制字符
+    pos++;
+    char decoded[4];
+    size_t n = 0;
+    JSONERROR code = tryDecodeEscape(data, len, pos, decoded, n);
+    if (code != JSONERROR::ERROR_NONE) return code;
+    compare(decoded, n);
+    runEnd = scanStringRun(data, len, pos);
+  }
+  pos++;  // 跳过最后的引号 '"'
+  match = match && matched == key.size();
+  return JSONERROR::ERROR_NONE;
+}
+
+// 只校验 pos 处 (指向起始引号) 的字符串, 不解码也不分配内存, 出错位置与
+// tryAppendString 相同; escaped 表示是否含转义, pos 移到结束引号之后
+inline JSONERROR tryValidateString(const char* data, size_t len, size_t& pos,
+                                   bool& escaped,
+                                   size_t readable = 0) noexcept {
+  escaped = false;
+  pos++;  // 跳过起始引号 '"'
+  while (true) {
+    pos = scanStringRun(data, len, pos, readable);
+    if (pos >= len) return JSONERROR::ERROR_UNEXPECTED_END;
+    char c = data[pos];
+    if (c == '"') break;
+    if (c != '\\') return JSONERROR::ERROR_INVALID_STRING;  // 控制字符
+    pos++;
+    char decoded[4];
+    size_t n = 0;
+    JSONERROR code = tryDecodeEscape(data, len, pos, decoded, n);
+    if (code != JSONERROR::ERROR_NONE) return code;
+    escaped = true;
+  }
+  pos++;  // 跳过最后的引号 '"'
+  return JSONERROR::ERROR_NONE;
+}
+
+// 从 pos 开始查找下一个 '"'、'[' '{'、']' '}' 字节, 用于跳过整个容器
+inline size_t scanBracketRun(const char* data, size_t len,
+                             size_t pos) noexcept {
+#if defined(YOYO_JSON_AVX2)
+  const __m256i quote32 = _mm256_set1_epi8('"');
+  const __m256i lower32 = _mm256_set1_epi8(0x20);  // '[' | 0x20 == '{'
+  const __m256i open32 = _mm256_set1_epi8('{');
+  const __m256i close32 = _mm256_set1_epi8('}');
+  while (pos + 32 <= len) {
+    __m256i chunk =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos));
+    __m256i folded = _mm256_or_si256(chunk, lower32);
+    __m256i special = _mm256_or_si256(
+        _mm256_cmpeq_epi8(chunk, quote32),
+        _mm256_or_si256(_mm256_cmpeq_epi8(folded, open32),
+                        _mm256_cmpeq_epi8(folded, close32)));
+    uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(special));
+    if (mask != 0) return pos + ctz32(mask);
+    pos += 32;
+  }
+#endif
+#if defined(YOYO_JSON_SSE2)
+  const __m128i quote16 = _mm_set1_epi8('"');
+  const __m128i lower16 = _mm_set1_epi8(0x20);
+  const __m128i open16 = _mm_set1_epi8('{');
+  const __m128i close16 = _mm_set1_epi8('}');
+  while (pos + 16 <= len) {
+    __m128i chunk =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+    __m128i folded = _mm_or_si128(chunk, lower16);
+    __m128i special =
+        _mm_or_si128(_mm_cmpeq_epi8(chunk, quote16),
+                     _mm_or_si128(_mm_cmpeq_epi8(folded, open16),
+                                  _mm_cmpeq_epi8(folded, close16)));
+    uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(special));
+    if (mask != 0) return pos + ctz32(mask);
+    pos += 16;
+  }
+#endif
+  while (pos < len) {
+    char c = data[pos];
+    if (c == '"' || c == '[' || c == ']' || c == '{' || c == '}') break;
+    pos++;
+  }
+  return pos;
+}
+
+// 跳过 pos 处 (指向起始引号) 的字符串, 不解码, pos 移到结束引号之后
+inline JSONERROR trySkipString(const char* data, size_t len,
+                               size_t& pos) noexcept {
+  pos++;
+  while (true) {
+    pos = scanStringRun(data, len, pos);
+    if (pos >= len) {
+      pos = len;
+      return JSONERROR::ERROR_UNEXPECTED_END;
+    }
+    if (data[pos] == '"') {
+      pos++;
+      return JSONERROR::ERROR_NONE;
+    }
+    pos += data[pos] == '\\' ? 2 : 1;  // 转义序列或控制字符
+  }
+}
+
+// 抛异常版本, 返回结束引号之后的位置
+inline size_t skipString(const char* data, size_t len, size_t pos) {
+  if (trySkipString(data, len, pos) != JSONERROR::ERROR_NONE) {
+    throw std::logic_error("unterminated string in JSON");
+  }
+  return pos;
+}
+
+// 跳过 pos 处的一个完整值 (不解码、不分配), 返回值之后的位置
+// 只匹配括号和字符串边界, 被跳过的内容不做完整的语法校验
+inline size_t skipValue(const char* data, size_t len, size_t pos) {
+  char c = data[pos];
+  if (c == '"') return skipString(data, len, pos);
+  if (c == '{' || c == '[') {
+    size_t depth = 0;
+    while (true) {
+      pos = scanBracketRun(data, len, pos);
+      if (pos >= len) {
+        throw std::logic_error("unexpected end of input in JSON container");
+      }
+      c = data[pos];
+      if (c == '"') {
+        pos = skipString(data, len, pos);
+        continue;
+      }
+      pos++;
+      if (c == '{' || c == '[') {
+        depth++;
+      } else if (--depth == 0) {
+        return pos;
+      }
+    }
+  }
+  // 标量: 一直到空白或分隔符
+  while (pos < len && !isJsonSpace(data[pos]) && data[pos] != ',' &&
+         data[pos] != ']' && data[pos] != '}') {
+    pos++;
+  }
+  return pos;
+}
+
+// 64 字节块的字符分类结果, 第 i 位对应块内第 i 个字节
+struct BlockMasks {
+  uint64_t quote;      // '"'
+  uint64_t backslash;  // '\\'
+  uint64_t space;      // 空白字符
+  uint64_t op;         // {}[]:,
+};
+
+inline BlockMasks classifyBlock(const char* block) noexcept {
+  BlockMasks m{0, 0, 0, 0};
+#if defined(YOYO_JSON_AVX2)
+  const __m256i quote = _mm256_set1_epi8('"');
+  const __m256i backslash = _mm256_set1_epi8('\\');
+  const __m256i space = _mm256_set1_epi8(' ');
+  const __m256i lf = _mm256_set1_epi8('\n');
+  const __m256i cr = _mm256_set1_epi8('\r');
+  const __m256i tab = _mm256_set1_epi8('\t');
+  const __m256i lower = _mm256_set1_epi8(0x20);  // '[' | 0x20 == '{'
+  const __m256i lbrace = _mm256_set1_epi8('{');
+  const __m256i rbrace = _mm256_set1_epi8('}');
+  const __m256i colon = _mm256_set1_epi8(':');
+  const __m256i comma = _mm256_set1_epi8(',');
+  for (int i = 0; i < 2; ++i) {
+    __m256i c =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32 * i));
+    __m256i folded = _mm256_or_si256(c, lower);
+    __m256i ws = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi8(c, space),
+                        _mm256_cmpeq_epi8(c, lf)),
+        _mm256_or_si256(_mm256_cmpeq_epi8(c, cr), _mm256_cmpeq_epi8(c, tab)));
+    __m256i op = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi8(folded, lbrace),
+                        _mm256_cmpeq_epi8(folded, rbrace)),
+        _mm256_or_si256(_mm256_cmpeq_epi8(c, colon),
+                        _mm256_cmpeq_epi8(c, comma)));
+    int shift = 32 * i;
+    m.quote |= static_cast<uint64_t>(static_cast<uint32_t>(
+                   _mm256_movemask_epi8(_mm256_cmpeq_epi8(c, quote))))
+               << shift;
+    m.backslash |= static_cast<uint64_t>(static_cast<uint32_t>(
+                       _mm256_movemask_epi8(_mm256_cmpeq_epi8(c, backslash))))
+                   << shift;
+    m.space |= static_cast<uint64_t>(
+                   static_cast<uint32_t>(_mm256_movemask_epi8(ws)))
+               << shift;
+    m.op |= static_cast<uint64_t>(
+                static_cast<uint32_t>(_mm256_movemask_epi8(op)))
+            << shift;
+  }
+#elif defined(YOYO_JSON_SSE2)
+  const __m128i quote = _mm_set1_epi8('"');
+  const __m128i backslash = _mm_set1_epi8('\\');
+  const __m128i space = _mm_set1_epi8(' ');
+  const __m128i lf = _mm_set1_epi8('\n');
+  const __m128i cr = _mm_set1_epi8('\r');
+  const __m128i tab = _mm_set1_epi8('\t');
+  const __m128i lower = _mm_set1_epi8(0x20);  // '[' | 0x20 == '{'
+  const __m128i lbrace = _mm_set1_epi8('{');
+  const __m128i rbrace = _mm_set1_epi8('}');
+  const __m128i colon = _mm_set1_epi8(':');
+  const __m128i comma = _mm_set1_epi8(',');
+  for (int i = 0; i < 4; ++i) {
+    __m128i c =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16 * i));
+    __m128i folded = _mm_or_si128(c, lower);
+    __m128i ws =
+        _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(c, space),
+                                  _mm_cmpeq_epi8(c, lf)),
+                     _mm_or_si128(_mm_cmpeq_epi8(c, cr),
+                                  _mm_cmpeq_epi8(c, tab)));
+    __m128i op =
+        _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(folded, lbrace),
+                                  _mm_cmpeq_epi8(folded, rbrace)),
+                     _mm_or_si128(_mm_cmpeq_epi8(c, colon),
+                                  _mm_cmpeq_epi8(c, comma)));
+    int shift = 16 * i;
+    m.quote |= static_cast<uint64_t>(
+                   _mm_movemask_epi8(_mm_cmpeq_epi8(c, quote)))
+               << shift;
+    m.backslash |= static_cast<uint64_t>(
+                       _mm_movemask_epi8(_mm_cmpeq_epi8(c, backslash)))
+                   << shift;
+    m.space |= static_cast<uint64_t>(_mm_movemask_epi8(ws)) << shift;
+    m.op |= static_cast<uint64_t>(_mm_movemask_epi8(op)) << shift;
+  }
+#else
+  for (int i = 0; i < 64; ++i) {
+    char c = block[i];
+    uint64_t bit = uint64_t{1} << i;
+    if (c == '"') m.quote |= bit;
+    if (c == '\\') m.backslash |= bit;
+    if (isJsonSpace(c)) m.space |= bit;
+    if (c == '{' || c == '}' || c == '[' || c == ']' || c == ':' || c == ',')
+      m.op |= bit;
+  }
+#endif
+  return m;
+}
+
+// 前缀异或: 第 i 位 = 第 0..i 位的异或, 用于计算引号内区间
+inline uint64_t prefixXor(uint64_t bits) noexcept {
+  bits ^= bits << 1;
+  bits ^= bits << 2;
+  bits ^= bits << 4;
+  bits ^= bits << 8;
+  bits ^= bits << 16;
+  bits ^= bits << 32;
+  return bits;
+}
+
+// 第一阶段: 一次扫描整个输入, 记录所有结构字符 ({}[]:,)、字符串起始引号
+// 以及标量 (数字/true/false/null) 起始字节的位置, 字符串内部的内容会被过滤掉
+// 返回 false 表示存在未闭合的字符串
+template <class Alloc>
+bool buildStructuralIndex(const char* data, size_t len,
+                          std::vector<uint32_t, Alloc>& indexes) {
+  indexes.clear();
+  indexes.reserve(len / 8 + 8);
+  uint64_t prevEscaped = 0;   // 上一块末尾的反斜杠是否转义了本块第一个字节
+  uint64_t prevInString = 0;  // 上一块结束时是否仍在字符串内 (全 0 或全 1)
+  uint64_t prevScalar = 0;    // 上一块最后一个字节是否为非引号标量字符
+  const uint64_t evenBits = 0x5555555555555555ULL;
+  char tail[64];
+  for (size_t base = 0; base < len; base += 64) {
+    const char* block = data + base;
+    if (len - base < 64) {  // 最后不足 64 字节的块用空白补齐
+      std::memset(tail, ' ', sizeof(tail));
+      std::memcpy(tail, block, len - base);
+      block = tail;
+    }
+    BlockMasks m = classifyBlock(block);
+
+    // 找出被转义的字符: 奇数长度的反斜杠序列之后的那个字节
+    uint64_t backslash = m.backslash & ~prevEscaped;
+    uint64_t followsEscape = (backslash << 1) | prevEscaped;
+    uint64_t oddStarts = backslash & ~evenBits & ~followsEscape;
+    uint64_t evenSeq = oddStarts + backslash;
+    prevEscaped = evenSeq < oddStarts ? 1 : 0;  // 进位
+    uint64_t escaped = (evenBits ^ (evenSeq << 1)) & followsEscape;
+
+    uint64_t quote = m.quote & ~escaped;
+    uint64_t inString = prefixXor(quote) ^ prevInString;
+    prevInString = static_cast<uint64_t>(static_cast<int64_t>(inString) >> 63);
+
+    // 标量起点: 非空白非结构字符, 且前一个字节不是非引号标量字符
+    uint64_t scalar = ~(m.op | m.space);
+    uint64_t nonQuoteScalar = scalar & ~quote;
+    uint64_t followsScalar = (nonQuoteScalar << 1) | prevScalar;
+    prevScalar = nonQuoteScalar >> 63;
+    uint64_t stringTail = inString ^ quote;  // 字符串内部和闭合引号
+    uint64_t structurals = (m.op | (scalar & ~followsScalar)) & ~stringTail;
+
+    if (structurals != 0) {
+      size_t n = indexes.size();
+      indexes.resize(n + popcount64(structurals));
+      uint32_t* out = indexes.data() + n;
+      while (structurals != 0) {
+        *out++ = static_cast<uint32_t>(base + ctz64(structurals));
+        structurals &= structurals - 1;
+      }
+    }
+  }
+  return prevInString == 0;
+}
+
+}  // namespace detail
+
+// 延迟解码的整数不超过 18 位, 一定在 int64 范围内
+inline JsonFiled::json_int JsonFiled::decodeInt(const json_raw& raw) {
+  const char* data = raw.sText.data();
+  bool negative = data[0] == '-';
+  size_t pos = negative ? 1 : 0;
+  uint64_t magnitude = 0;
+  detail::tryParseDigits(data, raw.sText.size(), pos, magnitude);
+  return negative ? -static_cast<json_int>(magnitude)
+                  : static_cast<json_int>(magnitude);
+}
+
+inline JsonFiled::json_double JsonFiled::decodeDouble(const json_raw& raw) {
+  size_t pos = 0;
+  return detail::parseDouble(raw.sText.data(), raw.sText.size(), pos);
+}
+
+inline JsonFiled::json_string JsonFiled::decodeString(const json_raw& raw) {
+  if (!raw.bEscaped) {
+    return json_string(raw.sText.substr(1, raw.sText.size() - 2));
+  }
+  json_string str;
+  size_t pos = 0;
+  detail::appendString(raw.sText.data(), raw.sText.size(), pos, str);
+  return str;
+}
+
+// 输出目标: 追加到调用方的 std::string, 按需增长
+class StringSink {
+ public:
+  explicit StringSink(std::string& out) : _sOut(out) {}
+  void write(const char* data, size_t len) { _sOut.append(data, len); }
+
+ private:
+  std::string& _sOut;
+};
+
+// 输出目标: 调用方提供的定长缓冲区 (不追加 '\0'). 放不下的部分被丢弃并
+// 记为溢出, required() 为完整输出需要的字节数, 可据此扩容后重新输出
+class BufferSink {
+ public:
+  BufferSink(char* buffer, size_t capacity) noexcept
+      : _pBuffer(buffer), _iCapacity(capacity) {}
+  template <size_t N>
+  explicit BufferSink(char (&buffer)[N]) noexcept : BufferSink(buffer, N) {}
+
+  void write(const char* data, size_t len) noexcept {
+    if (_iRequired < _iCapacity) {
+      size_t room = _iCapacity - _iRequired;
+      std::memcpy(_pBuffer + _iRequired, data, len < room ? len : room);
+    }
+    _iRequired += len;
+  }
+  size_t size() const noexcept {
+    return _iRequired < _iCapacity ? _iRequired : _iCapacity;
+  }
+  size_t required() const noexcept { return _iRequired; }
+  bool overflowed() const noexcept { return _iRequired > _iCapacity; }
+  std::string_view view() const noexcept { return {_pBuffer, size()}; }
+
+ private:
+  char* _pBuffer;
+  size_t _iCapacity;
+  size_t _iRequired{0};
+};
+
+// 输出目标: 文件描述符. 攒满 chunkSize 字节才调用一次 write, flush() 或析构
+// 时写出剩余内容; 写失败后丢弃后续输出, ok() 返回 false. 不关闭 fd
+class FdSink {
+ public:
+  explicit FdSink(int fd, size_t chunkSize = 64 * 1024)
+      : _iFd(fd), _vBuffer(chunkSize > 0 ? chunkSize : 1) {}
+  FdSink(const FdSink&) = delete;
+  FdSink& operator=(const FdSink&) = delete;
+  ~FdSink() { flush(); }
+
+  void write(const char* data, size_t len) {
+    if (len > _vBuffer.size() - _iUsed) {
+      flush();
+      if (len >= _vBuffer.size()) {  // 大块内容直接写出, 不经过缓冲区
+        writeAll(data, len);
+        return;
+      }
+    }
+    std::memcpy(_vBuffer.data() + _iUsed, data, len);
+    _iUsed += len;
+  }
+  bool flush() {
+    writeAll(_vBuffer.data(), _iUsed);
+    _iUsed = 0;
+    return _bOk;
+  }
+  bool ok() const noexcept { return _bOk; }
+
+ private:
+  void writeAll(const char* data, size_t len) {
+    while (_bOk && len > 0) {
+#if defined(_WIN32)
+      unsigned chunk = len > INT_MAX ? INT_MAX : static_cast<unsigned>(len);
+      auto written = ::_write(_iFd, data, chunk);
+#else
+      auto written = ::write(_iFd, data, len);
+#endif
+      if (written < 0) {
+        if (errno == EINTR) continue;
+        _bOk = false;
+        break;
+      }
+      data += written;
+      len -= static_cast<size_t>(written);
+    }
+  }
+
+  int _iFd;
+  std::vector<char> _vBuffer;
+  size_t _iUsed{0};
+  bool _bOk{true};
+};
+
+// 输出目标: std::ostream, 由流自己的缓冲区攒批
+class OStreamSink {
+ public:
+  explicit OStreamSink(std::ostream& os) : _os(os) {}
+  void write(const char* data, size_t len) {
+    _os.write(data, static_cast<std::streamsize>(len));
+  }
+
+ private:
+  std::ostream& _os;
+};
+
+// 把整棵树输出到 Sink: 所有内容按顺序追加到同一个输出, 不产生临时字符串.
+// Sink 只需提供 write(const char* data, size_t len), 见 StringSink,
+// BufferSink, FdSink, OStreamSink; 输出格式见 JsonWriteOptions
+template <class Sink>
+class JsonWriter {
+ public:
+  explicit JsonWriter(Sink& sink, const JsonWriteOptions& options = {})
+      : _sink(sink), _options(options) {
+    if (_options.pretty) {  // 换行加缩进, 按需加长, 每次只需一次 write
+      _sIndent.assign(1 + _options.indentWidth * 16, _options.indentChar);
+      _sIndent[0] = '\n';
+    }
+  }
+
+  // depth 为起始缩进层数, 只影响格式化输出中嵌套内容的缩进.
+  // 未闭合的容器保存在显式栈上, 输出不随嵌套深度递归
+  void write(const JsonFiled& value, size_t depth = 0) {
+    _sStack.resize(0);  // 上次输出可能因异常中断
+    writeValue(value);
+    while (!_sStack.empty()) {
+      Frame& frame = _sStack.back();
+      const size_t level = depth + _sStack.size();  // 当前容器中元素的层数
+      const JsonFiled& container = *frame.pContainer;
+      if (container._eStorage == JsonFiled::STORAGE::ARRAY) {
+        const JsonFiled::json_array& array = *container._uValue.pArray;
+        if (frame.iNext == array.size()) {
+          if (frame.bMultiline) newline(level - 1);
+          put(']');
+          _sStack.pop_back();
+          continue;
+        }
+        if (frame.iNext != 0)
+          writeRaw(_options.pretty && !frame.bMultiline ? ", " : ",");
+        if (frame.bMultiline) newline(level);
+        writeValue(array[frame.iNext++]);  // 可能压栈, 之后不再用 frame
+      } else {
+        const JsonFiled::json_object& object = *container._uValue.pObject;
+        if (frame.iNext == object.size()) {
+          if (_options.pretty) newline(level - 1);
+          put('}');
+          _sStack.pop_back();
+          continue;
+        }
+        if (frame.iNext != 0) put(',');
+        if (_options.pretty) newline(level);
+        const auto& member = *(object.begin() + frame.iNext++);
+        writeString(member.first.view());
+        writeRaw(_options.pretty ? ": " : ":");
+        writeValue(member.second);
+      }
+    }
+  }
+
+ private:
+  struct Frame {
+    const JsonFiled* pContainer;
+    size_t iNext;     // 下一个要输出的元素下标
+    bool bMultiline;  // 数组元素是否各占一行
+  };
+
+  // 标量和空容器直接输出, 非空容器输出起始括号后压栈
+  void writeValue(const JsonFiled& value) {
+    // 未转换的标量原样输出
+    if (value.isRaw()) {
+      writeRaw(value.view());
+      return;
+    }
+    switch (value._jType) {
+      case JSONTYPE::JSON_NULL:
+        writeRaw("null");
+        break;
+      case JSONTYPE::JSON_BOOLEAN:
+        writeRaw(value._uValue.bValue ? "true" : "false");
+        break;
+      case JSONTYPE::JSON_NUMBER:
+      case JSONTYPE::JSON_DOUBLE:
+        writeNumber(value);
+        break;
+      case JSONTYPE::JSON_STRING:
+        writeString(value.stringView());
+        break;
+      case JSONTYPE::JSON_ARRAY:
+        openArray(value);
+        break;
+      case JSONTYPE::JSON_OBJECT:
+        if (value._uValue.pObject->empty()) {
+          writeRaw("{}");
+        } else {
+          put('{');
+          _sStack.push_back(Frame{&value, 0, false});
+        }
+        break;
+      default:
+        throw std::logic_error("Unknown JSON type");
+    }
+  }
+
+  void openArray(const JsonFiled& value) {
+    const JsonFiled::json_array& array = *value._uValue.pArray;
+    if (array.empty()) {
+      writeRaw("[]");
+      return;
+    }
+    // 格式化输出时, 只含标量的数组可以写在一行
+    bool multiline = _options.pretty;
+    if (multiline && _options.compactScalarArrays) {
+      multiline = false;
+      for (const JsonFiled& element : array) {
+        if (element.isArray() || element.isObject()) {
+          multiline = true;
+          break;
+        }
+      }
+    }
+    put('[');
+    _sStack.push_back(Frame{&value, 0, multiline});
+  }
+
+  // 从预先填好的缩进串中截取, 换行和缩进一次写出
+  void newline(size_t depth) {
+    size_t len = 1 + depth * _options.indentWidth;
+    if (len > _sIndent.size()) {
+      _sIndent.resize(len > _sIndent.size() * 2 ? len : _sIndent.size() * 2,
+                      _options.indentChar);
+    }
+    _sink.write(_sIndent.data(), len);
+  }
+
+  void put(char c) { _sink.write(&c, 1); }
+  void writeRaw(std::string_view text) {
+    _sink.write(text.data(), text.size());
+  }
+
+  // 整数查两位数字表, 浮点数按最短往返格式, 先写到栈上的缓冲区
+  void writeNumber(const JsonFiled& value) {
+    char buffer[detail::NUMBER_BUFFER_SIZE];
+    char* end;
+    if (value._eStorage == JsonFiled::STORAGE::INT) {
+      end = detail::writeInt(buffer, value._uValue.iValue);
+    } else if (value._eStorage == JsonFiled::STORAGE::UINT) {
+      end = detail::writeUInt(buffer, value._uValue.uValue);
+    } else {
+      end = detail::writeDouble(buffer, value._uValue.dValue);
+    }
+    _sink.write(buffer, static_cast<size_t>(end - buffer));
+  }
+
+  // 用 SIMD 一次检查 16/32 字节, 不需要转义的连续字节整段写出,
+  // 需要转义的字节查表输出
+  void writeString(std::string_view str) {
+    put('"');
+    const char* data = str.data();
+    const size_t len = str.size();
+    size_t pos = 0;
+    while (true) {
+      size_t end = detail::scanStringRun(data, len, pos);
+      _sink.write(data + pos, end - pos);
+      if (end >= len) break;
+      writeRaw(detail::escapeSequence(static_cast<unsigned char>(data[end])));
+      pos = end + 1;
+    }
+    put('"');
+  }
+
+  Sink& _sink;
+  JsonWriteOptions _options;
+  std::string _sIndent;  // '\n' 加若干缩进字符
+  detail::SmallStack<Frame, 32> _sStack;  // 未闭合的容器
+};
+
+// 把 value 输出到 sink, 默认紧凑输出
+template <class Sink>
+inline void writeJson(const JsonFiled& value, Sink& sink,
+                      const JsonWriteOptions& options = {}) {
+  JsonWriter<Sink>(sink, options).write(value);
+}
+
+inline std::string JsonFiled::writeToString() const {
+  std::string out;
+  StringSink sink(out);
+  writeJson(*this, sink);
+  return out;
+}
+
+inline std::string JsonFiled::writeToString(
+    const JsonWriteOptions& options) const {
+  std::string out;
+  StringSink sink(out);
+  writeJson(*this, sink, options);
+  return out;
+}
+
+class JsonParseError : public std::logic_error {
+ public:
+  JsonParseError(const std::string& msg, size_t index)
+      : std::logic_error("JSON Parse Error at index " + std::to_string(index) +
+                         ": " + msg),
+        _index(index) {}
+  JsonParseError(JSONERROR code, size_t index)
+      : JsonParseError(errorMessage(code), index) {
+    _eCode = code;
+  }
+  size_t getErrorIndex() const { return _index; }
+  JSONERROR getErrorCode() const noexcept { return _eCode; }
+
+ private:
+  size_t _index;
+  JSONERROR _eCode{JSONERROR::ERROR_INVALID_VALUE};
+};
+
+// 不抛异常的解析结果: error 为 ERROR_NONE 时 value 有效,
+// 否则 offset 为出错的字节位置
+struct JsonResult {
+  JsonFiled value;
+  JSONERROR error{JSONERROR::ERROR_NONE};
+  size_t offset{0};
+
+  bool ok() const noexcept { return error == JSONERROR::ERROR_NONE; }
+  explicit operator bool() const noexcept { return ok(); }
+  const char* message() const noexcept { return errorMessage(error); }
+};
+
+// 不建树的解析 (SAX) 的结果: error 为 ERROR_NONE 时整个输入合法,
+// 否则 offset 为出错的字节位置
+struct JsonStatus {
+  JSONERROR error{JSONERROR::ERROR_NONE};
+  size_t offset{0};
+
+  bool ok() const noexcept { return error == JSONERROR::ERROR_NONE; }
+  explicit operator bool() const noexcept { return ok(); }
+  const char* message() const noexcept { return errorMessage(error); }
+};
+
+// SAX 事件处理器的默认实现: 所有事件都不做任何事并继续解析. 自定义处理器
+// 可以继承它并只定义需要的事件 (同名方法隐藏默认实现, 不是虚函数), 也可以
+// 是任何提供这些方法的类型. 事件返回 false 时停止解析, 结果为 ERROR_ABORTED.
+// string/key 收到的视图在不含转义时指向输入, 否则指向 parser 内部的临时
+// 缓冲区, 只在本次回调期间有效
+struct JsonSaxHandler {
+  bool null() { return true; }
+  bool boolean(bool) { return true; }
+  bool int64(int64_t) { return true; }
+  bool uint64(uint64_t) { return true; }  // 超出 int64 范围的非负整数
+  bool float64(double) { return true; }   // 浮点数和超出 64 位范围的整数
+  bool string(std::string_view) { return true; }
+  bool key(std::string_view) { return true; }
+  bool startObject() { return true; }
+  bool endObject() { return true; }
+  bool startArray() { return true; }
+  bool endArray() { return true; }
+};
+
+// JsonParser 不拷贝输入, 只引用调用方的字节:
+//  - string_view / (const char*, size_t) / const std::string& 构造时, 调用方的
+//    缓冲区必须在 parser 的整个使用期间保持有效且不被修改; 解析得到的
+//    JsonFiled 树拥有自己的数据, 不再引用输入
+//  - 传入 std::string 右值时, parser 接管这块内存 (移动, 不拷贝)
+//  - (data, len, readable) 构造表示 data 起至少有 readable 字节可读, 当
+//    readable >= len + JSON_PADDING 时扫描可以整块越过 len 读取, 填充字节的
+//    内容不影响结果
+//  - 拷贝/移动 parser 时, 引用的仍是同一块调用方缓冲区
+//  - STRING_BORROW/STRING_INSITU 模式下结果树中的字符串和键引用输入缓冲区,
+//    整棵树 (及其拷贝) 的生命周期与该缓冲区绑定; STRING_INSITU 需要通过
+//    (char*, size_t) 构造传入可写缓冲区, 解析会修改其中含转义的字符串
+// 输入格式错误不会在解析内部抛出异常: tryParse 返回错误码和字节位置,
+// parse/parser 等接口只是在其之上把错误转换为 JsonParseError
+class JsonParser {
+ public:
+  explicit JsonParser(std::string_view json)
+      : _jsonstring(json), _iIndex(0), _iReadable(json.size()) {}
+  JsonParser(const char* data, size_t len)
+      : JsonParser(std::string_view(data, len)) {}
+  // 可写缓冲区, 允许 STRING_INSITU 模式原位解码
+  JsonParser(char* data, size_t len)
+      : JsonParser(std::string_view(data, len)) {
+    _pMutable = data;
+  }
+  JsonParser(const char* data, size_t len, size_t readable)
+      : _jsonstring(data, len), _iIndex(0), _iReadable(readable) {}
+  explicit JsonParser(const char* json)
+      : JsonParser(std::string_view(json)) {}
+  explicit JsonParser(const std::string& jsonstr)
+      : JsonParser(std::string_view(jsonstr)) {}
+  explicit JsonParser(std::string&& jsonstr)
+      : _sOwned(std::move(jsonstr)), _bOwned(true) {
+    _jsonstring = _sOwned;
+    _iIndex = 0;
+    _iReadable = _sOwned.size();
+  }
+  JsonParser(const JsonParser& other)
+      : _sOwned(other._sOwned), _bOwned(other._bOwned) {
+    _jsonstring = _bOwned ? std::string_view(_sOwned) : other._jsonstring;
+    _iIndex = other._iIndex;
+    _iReadable = other._iReadable;
+    _vStructurals = other._vStructurals;
+    _iStructural = other._iStructural;
+    _pMutable = other._pMutable;
+    _eStringMode = other._eStringMode;
+    _pArena = other._pArena;
+    _pKeyDict = other._pKeyDict;
+    _bLazyScalars = other._bLazyScalars;
+    _iMaxDepth = other._iMaxDepth;
+  }
+  JsonParser& operator=(const JsonParser& other) {
+    if (this != &other) {
+      _sOwned = other._sOwned;
+      _bOwned = other._bOwned;
+      _jsonstring = _bOwned ? std::string_view(_sOwned) : other._jsonstring;
+      _iIndex = other._iIndex;
+      _iReadable = other._iReadable;
+      _vStructurals = other._vStructurals;
+      _iStructural = other._iStructural;
+      _pMutable = other._pMutable;
+      _eStringMode = other._eStringMode;
+      _pArena = other._pArena;
+      _pKeyDict = other._pKeyDict;
+      _bLazyScalars = other._bLazyScalars;
+      _iMaxDepth = other._iMaxDepth;
+    }
+    return *this;
+  }
+  JsonParser(JsonParser&& other)
+      : _sOwned(std::move(other._sOwned)), _bOwned(other._bOwned) {
+    // 短字符串优化下移动会改变数据地址, 需要重新指向
+    _jsonstring = _bOwned ? std::string_view(_sOwned) : other._jsonstring;
+    _iIndex = other._iIndex;
+    _iReadable = other._iReadable;
+    _vStructurals = std::move(other._vStructurals);
+    _iStructural = other._iStructural;
+    _pMutable = other._pMutable;
+    _eStringMode = other._eStringMode;
+    _pArena = other._pArena;
+    _pKeyDict = other._pKeyDict;
+    _bLazyScalars = other._bLazyScalars;
+    _iMaxDepth = other._iMaxDepth;
+  }
+  JsonParser& operator=(JsonParser&& other) {
+    if (this != &other) {
+      _sOwned = std::move(other._sOwned);
+      _bOwned = other._bOwned;
+      _jsonstring = _bOwned ? std::string_view(_sOwned) : other._jsonstring;
+      _iIndex = other._iIndex;
+      _iReadable = other._iReadable;
+      _vStructurals = std::move(other._vStructurals);
+      _iStructural = other._iStructural;
+      _pMutable = other._pMutable;
+      _eStringMode = other._eStringMode;
+      _pArena = other._pArena;
+      _pKeyDict = other._pKeyDict;
+      _bLazyScalars = other._bLazyScalars;
+      _iMaxDepth = other._iMaxDepth;
+    }
+    return *this;
+  }
+  ~JsonParser() = default;
+
+ public:
+  // 绑定 arena 后, 数组、对象节点和所有字符串 (拷贝进 arena 后以借用形式
+  // 保存) 都从 arena 分配, 见 parserJsonArena; 传 nullptr 恢复默认
+  void setArena(JsonArena* arena) { _pArena = arena; }
+
+  // 绑定键字典后, 对象的键都驻留在 dict 中 (优先于借用/arena 方式), 重复的键
+  // 不再各自分配; 传 nullptr 恢复默认
+  void setKeyDict(JsonKeyDict* dict) { _pKeyDict = dict; }
+
+  // 延迟解码: 数字和字符串值只校验语法并记录输入中的原文, 读取时才转换
+  // (每次读取都重新转换, 需要多次读取的值应保存结果), 未修改的值序列化时
+  // 原样输出; 优先于 STRINGMODE, 结果树不能比输入活得久. 对象的键不受影响
+  void setLazyScalars(bool lazy) { _bLazyScalars = lazy; }
+
+  // 设置字符串的存储方式, 见 STRINGMODE
+  void setStringMode(STRINGMODE mode) {
+    if (mode == STRINGMODE::STRING_INSITU && _pMutable == nullptr) {
+      throw std::logic_error("in-situ parsing requires a mutable buffer");
+    }
+    _eStringMode = mode;
+  }
+
+  // 不因输入格式错误抛出异常: 出错时返回错误码和出错的字节位置, 结果中的
+  // value 为 null (内存不足等仍会抛出). 每次调用都从输入起始重新解析
+  JsonResult tryParse(PARSEMODE mode = PARSEMODE::PARSE_RECURSIVE) {
+    _iIndex = 0;
+    _eError = JSONERROR::ERROR_NONE;
+    _iErrorPos = 0;
+    JsonResult result;
+    if (_jsonstring.empty()) {
+      fail(JSONERROR::ERROR_EMPTY_INPUT, 0);
+    } else if (mode == PARSEMODE::PARSE_INDEXED) {
+      result.value = indexedRoot();
+    } else if (mode == PARSEMODE::PARSE_ITERATIVE) {
+      result.value = iterativeRoot();
+    } else {
+      result.value = parseValue(0);
+      if (!failed()) checkTrailing();
+    }
+    if (failed()) {
+      result.value = JsonFiled();
+      result.error = _eError;
+      result.offset = _iErrorPos;
+    }
+    return result;
+  }
+
+  // 按 mode 选择解析方式, 输入格式错误时抛出 JsonParseError
+  JsonFiled parse(PARSEMODE mode = PARSEMODE::PARSE_RECURSIVE) {
+    JsonResult result = tryParse(mode);
+    if (!result) throw JsonParseError(result.error, result.offset);
+    return std::move(result.value);
+  }
+
+  // 逐字节递归下降
+  JsonFiled parser() { return parse(PARSEMODE::PARSE_RECURSIVE); }
+
+  // 两阶段解析: 先用 SIMD 一次性构建结构字符索引, 再沿索引建树,
+  // 字符串和标量仍复用 parseString/parseNumber 等方法, 结果与 parser() 一致
+  JsonFiled parserIndexed() { return parse(PARSEMODE::PARSE_INDEXED); }
+
+  // 迭代解析: 用显式栈保存未闭合的容器, 不随嵌套深度递归, 深层文档不会
+  // 耗尽调用栈
+  JsonFiled parserIterative() { return parse(PARSEMODE::PARSE_ITERATIVE); }
+
+  // 运行时设置最大嵌套层数 (默认 64); 很深的文档应配合 PARSE_ITERATIVE,
+  // 递归模式每层都占用调用栈, 不论怎样设置都不超过 MAX_RECURSIVE_DEPTH
+  void setMaxDepth(size_t depth) { _iMaxDepth = depth; }
+  size_t getMaxDepth() const noexcept { return _iMaxDepth; }
+  static constexpr size_t MAX_RECURSIVE_DEPTH = 1024;
+
+  // SAX 解析: 不建树, 按文档顺序把每个值作为事件交给 handler (见
+  // JsonSaxHandler), handler 类型是模板参数, 事件调用可以内联.
+  // 与建树使用同一套扫描与数字转换, 接受的输入和错误位置与 tryParse
+  // 一致, 只是重复的键不算错误, 由 handler 自行处理. 不递归, 嵌套深度
+  // 只受 setMaxDepth 限制; 不含转义的字符串不分配内存
+  template <class Handler>
+  JsonStatus parseSax(Handler& handler) {
+    _iIndex = 0;
+    _eError = JSONERROR::ERROR_NONE;
+    _iErrorPos = 0;
+    if (_jsonstring.empty()) {
+      fail(JSONERROR::ERROR_EMPTY_INPUT, 0);
+    } else {
+      saxRoot(handler);
+      if (!failed()) checkTrailing();
+    }
+    return JsonStatus{_eError, _iErrorPos};
+  }
+
+  // 只校验不建树: 与 tryParse 使用同一套语法检查 (SAX 路径, 字符串只校验
+  // 不解码), 同一对象中解码后相同的键同样报告 ERROR_DUPLICATE_KEY, 接受的
+  // 输入与错误位置都与 tryParse 一致. 通常不分配内存: 只有嵌套超过 1024
+  // 层、同时未闭合的对象超过 64 个, 或键较多 (例如未闭合对象共有超过 64
+  // 个键) 时才使用堆.
+  // checkUtf8 为 true 时还要求整个输入是合法的 UTF-8 (tryParse 不检查),
+  // 两种错误都存在时报告位置靠前的一个
+  JsonStatus validate(bool checkUtf8 = false) {
+    ValidateHandler handler;
+    JsonStatus status = parseSax(handler);
+    if (checkUtf8) {
+      size_t bad = detail::findInvalidUtf8(_jsonstring.data(),
+                                           _jsonstring.size());
+      if (bad < _jsonstring.size() && (status.ok() || bad < status.offset)) {
+        status = JsonStatus{JSONERROR::ERROR_INVALID_UTF8, bad};
+      }
+    }
+    return status;
+  }
+
+ private:
+  // 解析过程不抛异常: 出错时记录第一个错误并返回占位值, 调用方检查
+  // failed() 后逐层返回
+  JsonFiled fail(JSONERROR code, size_t pos) {
+    if (_eError == JSONERROR::ERROR_NONE) {
+      _eError = code;
+      _iErrorPos = pos;
+    }
+    return JsonFiled();
+  }
+  // 在当前位置出错, 输入已结束时报告为截断
+  JsonFiled failAt(JSONERROR code) {
+    if (_iIndex >= _jsonstring.size()) code = JSONERROR::ERROR_UNEXPECTED_END;
+    return fail(code, _iIndex);
+  }
+  bool failed() const noexcept { return _eError != JSONERROR::ERROR_NONE; }
+
+  // 根值之后只允许空白
+  void checkTrailing() {
+    _iIndex = detail::skipWhitespace(_jsonstring.data(), _jsonstring.size(),
+                                     _iIndex, _iReadable);
+    if (_iIndex != _jsonstring.size()) {
+      fail(JSONERROR::ERROR_TRAILING_CONTENT, _iIndex);
+    }
+  }
+
+  size_t recursiveDepthLimit() const noexcept {
+    return _iMaxDepth < MAX_RECURSIVE_DEPTH ? _iMaxDepth : MAX_RECURSIVE_DEPTH;
+  }
+
+  // CurrentDepth 为当前值所在的容器嵌套层数, 每进入一层数组/对象加 1
+  JsonFiled parseValue(size_t CurrentDepth) {
+    char sToken = getNextToken();
+    if (sToken == '[' || sToken == '{') {
+      if (CurrentDepth >= recursiveDepthLimit()) {
+        return fail(JSONERROR::ERROR_DEPTH_EXCEEDED, _iIndex);
+      }
+      if (sToken == '[') return parseArray(CurrentDepth + 1);  // 数组
+      return parseObject(CurrentDepth + 1);                    // 对象
+    }
+    return parseScalar(sToken);
+  }
+
+  // 根据当前字符分辨标量类型, 三种解析模式共用
+  JsonFiled parseScalar(char sToken) {
+    if (sToken == 'n') return parseNull();                      // null
+    if (sToken == 't' || sToken == 'f') return parseBoolean();  // true/false
+    if (sToken == '-' || (sToken >= '0' && sToken <= '9')) {
+      return parseNumber();  // 数字
+    }
+    if (sToken == '\"') return parseString();  // 字符串
+    return failAt(JSONERROR::ERROR_INVALID_VALUE);
+  }
+
+  JsonFiled parseArray(size_t CurrentDepth) {
+    JsonFiled::json_array vJvalue(newArray());
+    _iIndex++;  // 跳过 '['
+    if (getNextToken() == ']') {
+      _iIndex++;                             // 跳过 ']'
+      return JsonFiled(std::move(vJvalue));  // 空数组
+    }
+    while (true) {
+      vJvalue.push_back(parseValue(CurrentDepth));
+      if (failed()) return JsonFiled();
+      char ch = getNextToken();
+      if (ch == ']') {
+        _iIndex++;  // 跳过 ']'
+        return JsonFiled(std::move(vJvalue));
+      }
+      if (ch != ',') return failAt(JSONERROR::ERROR_EXPECTED_SEPARATOR);
+      _iIndex++;  // 跳过 ',' 分隔符
+    }
+  }
+
+  JsonFiled parseObject(size_t CurrentDepth) {
+    JsonFiled::json_object mJvalue(newObject());
+    _iIndex++;  // 跳过 '{'
+    if (getNextToken() == '}') {
+      _iIndex++;                             // 跳过 '}'
+      return JsonFiled(std::move(mJvalue));  // 空对象
+    }
+    while (true) {
+      size_t iSlot = 0;
+      if (!readMember(mJvalue, iSlot)) return JsonFiled();
+      JsonFiled value = parseValue(CurrentDepth);
+      if (failed()) return JsonFiled();
+      mJvalue.begin()[iSlot].second = std::move(value);
+      char ch = getNextToken();
+      if (ch == '}') {
+        _iIndex++;  // 跳过 '}'
+        return JsonFiled(std::move(mJvalue));
+      }
+      if (ch != ',') return failAt(JSONERROR::ERROR_EXPECTED_SEPARATOR);
+      _iIndex++;  // 跳过 ',' 分隔符
+    }
+  }
+
+  // 读取对象成员的 "key": 并插入占位值 (查重与插入只做一次查找),
+  // iSlot 为该成员的下标, 值解析完成后再填入
+  bool readMember(JsonFiled::json_object& obj, size_t& iSlot) {
+    if (getNextToken() != '\"') {
+      failAt(JSONERROR::ERROR_EXPECTED_KEY);
+      return false;
+    }
+    size_t keyPos = _iIndex;
+    JsonKey sKey = parseKey();
+    if (failed()) return false;
+    if (getNextToken() != ':') {
+      failAt(JSONERROR::ERROR_EXPECTED_COLON);
+      return false;
+    }
+    auto [itMember, bNew] = obj.emplace(std::move(sKey), JsonFiled());
+    if (!bNew) {
+      fail(JSONERROR::ERROR_DUPLICATE_KEY, keyPos);
+      return false;
+    }
+    iSlot = static_cast<size_t>(itMember - obj.begin());
+    _iIndex++;  // 跳过 ':'
+    return true;
+  }
+
+  // 迭代解析中一个未闭合的容器; 对象的值先以占位成员插入, iSlot 为其下标
+  struct IterFrame {
+    JsonFiled::json_array vArray;
+    JsonFiled::json_object mObject;
+    size_t iSlot{0};
+    bool bObject{false};
+  };
+
+  IterFrame newFrame(bool bObject) const {
+    IterFrame frame{newArray(), newObject()};
+    frame.bObject = bObject;
+    return frame;
+  }
+
+  JsonFiled finishFrame(IterFrame& frame) const {
+    if (frame.bObject) return JsonFiled(std::move(frame.mObject));
+    return JsonFiled(std::move(frame.vArray));
+  }
+
+  // 显式栈状态机; 与 indexedRoot 一样拒绝根值之后的多余内容
+  JsonFiled iterativeRoot() {
+    std::vector<IterFrame, ArenaAllocator<IterFrame>> vStack(
+        (ArenaAllocator<IterFrame>(_pArena)));
+    JsonFiled value;  // 刚解析完成的值
+    while (true) {
+      // 读取一个值: 标量直接完成; 容器入栈后继续读取它的第一个元素
+      char sToken = getNextToken();
+      switch (sToken) {
+        case '[':
+        case '{': {
+          if (vStack.size() >= _iMaxDepth) {
+            return fail(JSONERROR::ERROR_DEPTH_EXCEEDED, _iIndex);
+          }
+          _iIndex++;  // 跳过 '[' / '{'
+          vStack.push_back(newFrame(sToken == '{'));
+          IterFrame& frame = vStack.back();
+          if (getNextToken() != (frame.bObject ? '}' : ']')) {
+            if (frame.bObject && !readMember(frame.mObject, frame.iSlot)) {
+              return JsonFiled();
+            }
+            continue;
           }
+          _iIndex++;  // 空容器
+          value = finishFrame(frame);
+          vStack.pop_back();
+          break;
+        }
+        default:
+          value = parseScalar(sToken);
+          if (failed()) return JsonFiled();
+      }
+      // 值已完成: 放入所在容器, 遇到 ',' 读取下一个元素, 遇到闭合符则该
+      // 容器完成并继续向外层归约
+      while (true) {
+        if (vStack.empty()) {
+          checkTrailing();
+          return value;
+        }
+        IterFrame& frame = vStack.back();
+        if (frame.bObject) {
+          frame.mObject.begin()[frame.iSlot].second = std::move(value);
+        } else {
+          frame.vArray.push_back(std::move(value));
+        }
+        char ch = getNextToken();
+        if (ch == ',') {
+          _iIndex++;
+          if (frame.bObject && !readMember(frame.mObject, frame.iSlot)) {
+            return JsonFiled();
+          }
+          break;
+        }
+        if (ch != (frame.bObject ? '}' : ']')) {
+          return failAt(JSONERROR::ERROR_EXPECTED_SEPARATOR);
+        }
+        _iIndex++;
+        value = finishFrame(frame);
+        vStack.pop_back();
       }
     }
-    return result;
   }
-  std::string intToHex(unsigned int value, int width) const {
-    std::ostringstream oss;
-    oss << std::hex << std::setw(width) << std::setfill('0') << value;
-    return oss.str();
+
+  JsonFiled indexedRoot() {
+    if (_jsonstring.size() > UINT32_MAX) {
+      return fail(JSONERROR::ERROR_INPUT_TOO_LARGE, UINT32_MAX);
+    }
+    // 绑定 arena 时索引也从 arena 分配; 上次的索引可能位于已 reset 的
+    // arena 中, 不能复用, 每次解析重新申请
+    if (_pArena || _vStructurals.get_allocator().arena()) {
+      _vStructurals = StructuralIndex(ArenaAllocator<uint32_t>(_pArena));
+    }
+    if (!detail::buildStructuralIndex(_jsonstring.data(), _jsonstring.size(),
+                                      _vStructurals)) {
+      return fail(JSONERROR::ERROR_UNEXPECTED_END, _jsonstring.size());
+    }
+    _iStructural = 0;
+    JsonFiled root = indexedValue(0);
+    if (failed()) return JsonFiled();
+    if (_iStructural != _vStructurals.size()) {
+      return fail(JSONERROR::ERROR_TRAILING_CONTENT,
+                  _vStructurals[_iStructural]);
+    }
+    return root;
+  }
+
+  // 取出下一个结构字符的位置, 已到末尾时记录错误并返回 false
+  bool nextStructural(size_t& pos) {
+    if (_iStructural >= _vStructurals.size()) {
+      fail(JSONERROR::ERROR_UNEXPECTED_END, _jsonstring.size());
+      return false;
+    }
+    pos = _vStructurals[_iStructural++];
+    return true;
+  }
+
+  // 标量必须恰好结束在下一个结构字符之前 (中间只允许空白)
+  bool checkScalarEnd() {
+    size_t end = _iStructural < _vStructurals.size()
+                     ? _vStructurals[_iStructural]
+                     : _jsonstring.size();
+    if (detail::skipWhitespace(_jsonstring.data(), end, _iIndex) != end) {
+      fail(JSONERROR::ERROR_INVALID_VALUE, _iIndex);
+      return false;
+    }
+    return true;
+  }
+
+  JsonFiled indexedValue(size_t currentDepth) {
+    if (!nextStructural(_iIndex)) return JsonFiled();
+    char sToken = _jsonstring[_iIndex];
+    if (sToken == '[' || sToken == '{') {
+      if (currentDepth >= recursiveDepthLimit()) {
+        return fail(JSONERROR::ERROR_DEPTH_EXCEEDED, _iIndex);
+      }
+      if (sToken == '[') return indexedArray(currentDepth + 1);
+      return indexedObject(currentDepth + 1);
+    }
+    JsonFiled value = parseScalar(sToken);
+    if (failed() || !checkScalarEnd()) return JsonFiled();
+    return value;
+  }
+
+  JsonFiled indexedArray(size_t currentDepth) {
+    JsonFiled::json_array vJvalue(newArray());
+    if (_iStructural < _vStructurals.size() &&
+        _jsonstring[_vStructurals[_iStructural]] == ']') {
+      _iStructural++;  // 跳过 ']'
+      return JsonFiled(std::move(vJvalue));
+    }
+    while (true) {
+      vJvalue.push_back(indexedValue(currentDepth));
+      if (failed()) return JsonFiled();
+      size_t pos = 0;
+      if (!nextStructural(pos)) return JsonFiled();
+      if (_jsonstring[pos] == ']') return JsonFiled(std::move(vJvalue));
+      if (_jsonstring[pos] != ',') {
+        return fail(JSONERROR::ERROR_EXPECTED_SEPARATOR, pos);
+      }
+    }
+  }
+
+  JsonFiled indexedObject(size_t currentDepth) {
+    JsonFiled::json_object mJvalue(newObject());
+    if (_iStructural < _vStructurals.size() &&
+        _jsonstring[_vStructurals[_iStructural]] == '}') {
+      _iStructural++;  // 跳过 '}'
+      return JsonFiled(std::move(mJvalue));
+    }
+    while (true) {
+      if (!nextStructural(_iIndex)) return JsonFiled();
+      if (_jsonstring[_iIndex] != '\"') {
+        return fail(JSONERROR::ERROR_EXPECTED_KEY, _iIndex);
+      }
+      size_t keyPos = _iIndex;
+      JsonKey sKey = parseKey();
+      if (failed() || !checkScalarEnd()) return JsonFiled();
+      size_t pos = 0;
+      if (!nextStructural(pos)) return JsonFiled();
+      if (_jsonstring[pos] != ':') {
+        return fail(JSONERROR::ERROR_EXPECTED_COLON, pos);
+      }
+      // 先占位再解析值, 查重与插入只做一次查找
+      auto [itMember, bNew] = mJvalue.emplace(std::move(sKey), JsonFiled());
+      if (!bNew) return fail(JSONERROR::ERROR_DUPLICATE_KEY, keyPos);
+      size_t iSlot = static_cast<size_t>(itMember - mJvalue.begin());
+      JsonFiled value = indexedValue(currentDepth);
+      if (failed()) return JsonFiled();
+      mJvalue.begin()[iSlot].second = std::move(value);
+      if (!nextStructural(pos)) return JsonFiled();
+      if (_jsonstring[pos] == '}') return JsonFiled(std::move(mJvalue));
+      if (_jsonstring[pos] != ',') {
+        return fail(JSONERROR::ERROR_EXPECTED_SEPARATOR, pos);
+      }
+    }
+  }
+
+  // 跳过空白后返回当前字符, 输入结束时返回 '\0'
+  char getNextToken() {
+    _iIndex = detail::skipWhitespace(_jsonstring.data(), _jsonstring.size(),
+                                     _iIndex, _iReadable);
+    return _iIndex < _jsonstring.size() ? _jsonstring[_iIndex] : '\0';
+  }
+
+  JsonFiled parseNull() {
+    // 直接比较 jsonstring 从 index 开始的 4 个字符是否为 "null"
+    if (_jsonstring.compare(_iIndex, 4, "null") == 0) {
+      _iIndex += 4;  // 移动索引，跳过 "null"
+      return JsonFiled();
+    }
+    return failAt(JSONERROR::ERROR_INVALID_LITERAL);
+  }
+  JsonFiled parseBoolean() {
+    // 比较 jsonstring 从 index 开始的 4 个字符是否为 "true"
+    if (_jsonstring.compare(_iIndex, 4, "true") == 0) {
+      _iIndex += 4;  // 移动索引，跳过 "true"
+      return JsonFiled(true);
+    }
+    // 比较 jsonstring 从 index 开始的 5 个字符是否为 "false"
+    if (_jsonstring.compare(_iIndex, 5, "false") == 0) {
+      _iIndex += 5;  // 移动索引，跳过 "false"
+      return JsonFiled(false);
+    }
+    return failAt(JSONERROR::ERROR_INVALID_LITERAL);
+  }
+
+  // 整数直接在输入上用 SWAR 转换为 int64/uint64, 不构造临时字符串;
+  // 浮点数和超出 64 位范围的整数转换为 double
+  JsonFiled parseNumber() {
+    if (_bLazyScalars) {
+      size_t end = _iIndex;
+      JSONTYPE type = rawNumber(end);
+      if (end != _iIndex) {
+        std::string_view text(_jsonstring.data() + _iIndex, end - _iIndex);
+        _iIndex = end;
+        return JsonFiled::rawScalar(type, text);
+      }
+    }
+    NumberToken number;
+    if (!readNumber(number)) return JsonFiled();
+    if (number.type == JSONTYPE::JSON_DOUBLE) return JsonFiled(number.dValue);
+    if (number.bUnsigned) return JsonFiled(number.uValue);
+    return JsonFiled(number.iValue);
+  }
+
+  // 一个数字的转换结果, 建树与 SAX 共用
+  struct NumberToken {
+    JSONTYPE type{JSONTYPE::JSON_NUMBER};  // JSON_NUMBER 或 JSON_DOUBLE
+    bool bUnsigned{false};                 // 超出 int64 范围的非负整数
+    int64_t iValue{0};
+    uint64_t uValue{0};
+    double dValue{0};
+  };
+
+  // 出错时记录错误并返回 false
+  bool readNumber(NumberToken& number) {
+    const char* data = _jsonstring.data();
+    size_t len = _jsonstring.size();
+    size_t start = _iIndex;  // 记录起始位置
+    bool negative = data[start] == '-';
+    size_t pos = start + (negative ? 1 : 0);
+    uint64_t magnitude = 0;
+    JSONERROR code = detail::tryParseIntegerPart(data, len, pos, magnitude);
+    if (code == JSONERROR::ERROR_INVALID_NUMBER) {
+      _iIndex = pos;
+      failAt(code);
+      return false;
+    }
+    if (code == JSONERROR::ERROR_NONE && !detail::isFloatTail(data, len, pos)) {
+      if (!negative) {  // 按范围存为 int64 或 uint64
+        _iIndex = pos;
+        if (magnitude <= static_cast<uint64_t>(INT64_MAX)) {
+          number.iValue = static_cast<int64_t>(magnitude);
+        } else {
+          number.bUnsigned = true;
+          number.uValue = magnitude;
+        }
+        return true;
+      }
+      if (magnitude <= static_cast<uint64_t>(INT64_MAX) + 1) {
+        _iIndex = pos;
+        number.iValue = static_cast<int64_t>(0 - magnitude);
+        return true;
+      }
+    }
+    double value = 0;
+    code = detail::tryParseDouble(data, len, _iIndex, value);
+    if (code == JSONERROR::ERROR_NUMBER_OUT_OF_RANGE) {
+      fail(code, start);
+      return false;
+    }
+    if (code != JSONERROR::ERROR_NONE) {
+      failAt(code);
+      return false;
+    }
+    number.type = JSONTYPE::JSON_DOUBLE;  // 浮点数
+    number.dValue = value;
+    return true;
+  }
+
+  // 延迟解码: 只校验数字语法, end 移到原文之后, 返回数字类型. 超过 18 位
+  // 的整数和指数超过两位的数可能超出 int64 或 double 范围, 与语法错误一样
+  // 保持 end 不变, 交给 parseNumber 立即转换, 以便在解析时报告错误
+  JSONTYPE rawNumber(size_t& end) const {
+    const char* data = _jsonstring.data();
+    const size_t len = _jsonstring.size();
+    const size_t start = end;
+    size_t pos = start + (data[start] == '-' ? 1 : 0);
+    const size_t intStart = pos;
+    uint64_t magnitude = 0;  // 只用 SWAR 扫过整数部分, 不使用结果
+    if (detail::tryParseIntegerPart(data, len, pos, magnitude) !=
+            JSONERROR::ERROR_NONE ||
+        pos - intStart > 18)
+      return JSONTYPE::JSON_NUMBER;
+    if (!detail::isFloatTail(data, len, pos)) {
+      end = pos;
+      return JSONTYPE::JSON_NUMBER;
+    }
+    bool isFloat = false;
+    pos = start;
+    if (detail::tryScanNumber(data, len, pos, isFloat) !=
+            JSONERROR::ERROR_NONE ||
+        pos - start > 64)
+      return JSONTYPE::JSON_DOUBLE;
+    size_t digits = 0;  // 指数位数
+    while (digits < pos - start && data[pos - 1 - digits] >= '0' &&
+           data[pos - 1 - digits] <= '9')
+      digits++;
+    char c = data[pos - 1 - digits];
+    if ((c == '+' || c == '-' || c == 'e' || c == 'E') && digits > 2)
+      return JSONTYPE::JSON_DOUBLE;
+    end = pos;
+    return JSONTYPE::JSON_DOUBLE;
+  }
+
+  JsonFiled parseString() {
+    JsonFiled tValue = parseStringStorage();
+    if (_pArena) tValue.markArenaString();
+    return tValue;
+  }
+
+  JsonFiled parseStringStorage() {
+    if (_bLazyScalars) return rawString();
+    std::string_view view;
+    if (borrowString(view)) return JsonFiled::borrowString(view);
+    if (_pArena) return JsonFiled::borrowString(arenaString());
+    return JsonFiled(parseStringValue());
+  }
+
+  // 延迟解码: 只校验字符串并记录含两侧引号的原文
+  JsonFiled rawString() {
+    size_t start = _iIndex;
+    bool escaped = false;
+    JSONERROR code = detail::tryValidateString(
+        _jsonstring.data(), _jsonstring.size(), _iIndex, escaped, _iReadable);
+    if (code != JSONERROR::ERROR_NONE) return fail(code, _iIndex);
+    return JsonFiled::rawScalar(
+        JSONTYPE::JSON_STRING,
+        std::string_view(_jsonstring.data() + start, _iIndex - start),
+        escaped);
+  }
+
+  JsonKey parseKey() {
+    if (_pKeyDict) return internKey();
+    std::string_view view;
+    if (borrowString(view)) return JsonKey::borrow(view);
+    if (_pArena) return JsonKey::borrow(arenaString());
+    return JsonKey(parseStringValue());
+  }
+
+  // 不含转义的键直接用输入中的字节查字典, 不分配内存
+  JsonKey internKey() {
+    const char* data = _jsonstring.data();
+    size_t start = _iIndex + 1;
+    size_t end = detail::scanStringRun(data, _jsonstring.size(), start,
+                                       _iReadable);
+    if (end < _jsonstring.size() && data[end] == '\"') {
+      _iIndex = end + 1;
+      return _pKeyDict->intern(std::string_view(data + start, end - start));
+    }
+    std::string sKey = parseStringValue();
+    if (failed()) return JsonKey();  // 出错的键不写入字典
+    return _pKeyDict->intern(sKey);
+  }
+
+  // 把字符串原文拷贝进 arena 后原位解码, 返回 arena 中的视图
+  std::string_view arenaString() {
+    size_t start = _iIndex;
+    size_t end = start;
+    JSONERROR code =
+        detail::trySkipString(_jsonstring.data(), _jsonstring.size(), end);
+    if (code != JSONERROR::ERROR_NONE) {
+      fail(code, end);
+      return std::string_view();
+    }
+    char* buffer = static_cast<char*>(_pArena->allocate(end - start, 1));
+    std::memcpy(buffer, _jsonstring.data() + start, end - start);
+    size_t pos = 0;
+    std::string_view view;
+    code = detail::tryUnescapeInPlace(buffer, end - start, pos, view);
+    if (code != JSONERROR::ERROR_NONE) fail(code, start + pos);
+    _iIndex = end;
+    return view;
+  }
+
+  // SAX: 显式栈只记录每层是否为对象 (每层一位), 不超过 1024 层时位于
+  // 栈上, 不分配内存
+  template <class Handler>
+  void saxRoot(Handler& handler) {
+    uint64_t inlineBits[16] = {};
+    std::vector<uint64_t> vHeapBits;
+    uint64_t* pBits = inlineBits;
+    if (_iMaxDepth > 64 * 16) {
+      vHeapBits.assign((_iMaxDepth + 63) / 64, 0);
+      pBits = vHeapBits.data();
+    }
+    size_t depth = 0;  // 未闭合的容器数
+    while (true) {
+      // 读取一个值: 容器发出开始事件后继续读取它的第一个元素,
+      // 空容器和标量直接完成
+      char sToken = getNextToken();
+      if (sToken == '[' || sToken == '{') {
+        if (depth >= _iMaxDepth) {
+          fail(JSONERROR::ERROR_DEPTH_EXCEEDED, _iIndex);
+          return;
+        }
+        bool bObject = sToken == '{';
+        uint64_t bit = uint64_t(1) << (depth & 63);
+        if (bObject) {
+          pBits[depth >> 6] |= bit;
+        } else {
+          pBits[depth >> 6] &= ~bit;
+        }
+        depth++;
+        _iIndex++;  // 跳过 '[' 或 '{'
+        if (!(bObject ? handler.startObject() : handler.startArray())) {
+          abortSax();
+          return;
+        }
+        if (getNextToken() != (bObject ? '}' : ']')) {
+          if (bObject && !saxKey(handler)) return;
+          continue;
+        }
+        _iIndex++;  // 跳过空容器的闭合括号
+        depth--;
+        if (!(bObject ? handler.endObject() : handler.endArray())) {
+          abortSax();
+          return;
+        }
+      } else if (!saxScalar(sToken, handler)) {
+        return;
+      }
+      // 值已完成: 读取分隔符, 或闭合所在的容器并继续向外
+      while (depth > 0) {
+        bool bObject = (pBits[(depth - 1) >> 6] >> ((depth - 1) & 63)) & 1;
+        char ch = getNextToken();
+        if (ch == ',') {
+          _iIndex++;  // 跳过 ',' 分隔符
+          if (bObject && !saxKey(handler)) return;
+          break;
+        }
+        if (ch != (bObject ? '}' : ']')) {
+          failAt(JSONERROR::ERROR_EXPECTED_SEPARATOR);
+          return;
+        }
+        _iIndex++;  // 跳过闭合括号
+        depth--;
+        if (!(bObject ? handler.endObject() : handler.endArray())) {
+          abortSax();
+          return;
+        }
+      }
+      if (depth == 0) return;
+    }
+  }
+
+  // 读取 "key": 并发出 key 事件
+  template <class Handler>
+  bool saxKey(Handler& handler) {
+    if (getNextToken() != '\"') {
+      failAt(JSONERROR::ERROR_EXPECTED_KEY);
+      return false;
+    }
+    size_t keyPos = _iIndex;
+    std::string_view key;
+    if (!readSaxString<Handler>(key)) return false;
+    if (getNextToken() != ':') {
+      failAt(JSONERROR::ERROR_EXPECTED_COLON);
+      return false;
+    }
+    _iIndex++;  // 跳过 ':'
+    if constexpr (std::is_same_v<Handler, ValidateHandler>) {
+      if (!handler.key(key)) {  // 与建树时一样报告在重复的键上
+        fail(JSONERROR::ERROR_DUPLICATE_KEY, keyPos);
+        return false;
+      }
+    } else if (!handler.key(key)) {
+      return abortSax();
+    }
+    return true;
+  }
+
+  // 与 parseScalar 分辨标量的方式相同
+  template <class Handler>
+  bool saxScalar(char sToken, Handler& handler) {
+    bool bContinue = true;
+    if (sToken == 'n') {
+      if (_jsonstring.compare(_iIndex, 4, "null") != 0) {
+        failAt(JSONERROR::ERROR_INVALID_LITERAL);
+        return false;
+      }
+      _iIndex += 4;
+      bContinue = handler.null();
+    } else if (sToken == 't' || sToken == 'f') {
+      bool value = sToken == 't';
+      if (_jsonstring.compare(_iIndex, value ? 4 : 5,
+                              value ? "true" : "false") != 0) {
+        failAt(JSONERROR::ERROR_INVALID_LITERAL);
+        return false;
+      }
+      _iIndex += value ? 4 : 5;
+      bContinue = handler.boolean(value);
+    } else if (sToken == '-' || (sToken >= '0' && sToken <= '9')) {
+      NumberToken number;
+      if (!readNumber(number)) return false;
+      if (number.type == JSONTYPE::JSON_DOUBLE) {
+        bContinue = handler.float64(number.dValue);
+      } else if (number.bUnsigned) {
+        bContinue = handler.uint64(number.uValue);
+      } else {
+        bContinue = handler.int64(number.iValue);
+      }
+    } else if (sToken == '\"') {
+      std::string_view view;
+      if (!readSaxString<Handler>(view)) return false;
+      bContinue = handler.string(view);
+    } else {
+      failAt(JSONERROR::ERROR_INVALID_VALUE);
+      return false;
+    }
+    return bContinue || abortSax();
+  }
+
+  // validate 使用的处理器: 字符串只校验不解码, 键以原文 (不含引号, 未解码)
+  // 传入, 只用于查找同一对象中的重复键. 与 BasicJsonObject 一样, 键较少时
+  // 线性比较, 超过 INDEX_THRESHOLD 个后为该对象建开放寻址索引. 只有最内层
+  // 的对象会新增键, 所以各对象的键记录和索引都按嵌套顺序压栈; 键不多的
+  // 文档全部放在处理器内部, 不分配内存
+  class ValidateHandler : public JsonSaxHandler {
+   public:
+    bool startObject() {
+      _sFrames.push_back(Frame{_sKeys.size(), _sIndex.size()});
+      return true;
+    }
+    bool endObject() {
+      const Frame& frame = _sFrames.back();
+      _sKeys.resize(frame.iFirstKey);
+      _sIndex.resize(frame.iFirstSlot);
+      _sFrames.pop_back();
+      return true;
+    }
+
+    // 返回 false 表示 raw 与所在对象中已有的键解码后相同
+    bool key(std::string_view raw) {
+      KeyRecord record = makeRecord(raw);
+      const Frame& frame = _sFrames.back();
+      const size_t slots = _sIndex.size() - frame.iFirstSlot;
+      if (slots == 0) {  // 线性查找时不需要哈希
+        for (size_t i = frame.iFirstKey; i < _sKeys.size(); i++) {
+          if (sameKey(_sKeys[i], record)) return false;
+        }
+      } else {
+        record.iHash = hashKey(record);
+        size_t mask = slots - 1;
+        for (size_t slot = record.iHash & mask;; slot = (slot + 1) & mask) {
+          uint32_t entry = _sIndex[frame.iFirstSlot + slot];
+          if (entry == 0) break;
+          if (sameKey(_sKeys[frame.iFirstKey + entry - 1], record))
+            return false;
+        }
+      }
+      _sKeys.push_back(record);
+      const size_t count = _sKeys.size() - frame.iFirstKey;
+      if (slots != 0 && count * 2 <= slots) {
+        insertIndex(frame, count - 1);
+      } else if (count > JsonFiled::json_object::INDEX_THRESHOLD) {
+        rebuildIndex(frame, count);
+      }
+      return true;
+    }
+
+   private:
+    struct KeyRecord {
+      std::string_view sRaw;
+      uint64_t iPrefix;  // 原文的前 8 个字节, 线性查找时先比较
+      size_t iHash;      // 解码后内容的哈希, 所在对象建索引后才计算
+      bool bEscaped;
+    };
+    struct Frame {
+      size_t iFirstKey;   // 该对象第一个键在 _sKeys 中的下标
+      size_t iFirstSlot;  // 该对象的索引在 _sIndex 中的起点
+    };
+
+    static KeyRecord makeRecord(std::string_view raw) noexcept {
+      KeyRecord record{raw, 0, 0, raw.find('\\') != std::string_view::npos};
+      size_t prefix = raw.size() < sizeof(uint64_t) ? raw.size() : 8;
+      std::memcpy(&record.iPrefix, raw.data(), prefix);
+      return record;
+    }
+
+    // 哈希按解码后的内容计算; 含转义的键先解码到栈上的缓冲区, 很长时才
+    // 使用临时字符串
+    static size_t hashKey(const KeyRecord& record) {
+      if (!record.bEscaped) return std::hash<std::string_view>()(record.sRaw);
+      char aDecoded[128];
+      size_t iDecoded = 0;
+      std::string sLong;
+      detail::DecodedReader reader(record.sRaw);
+      for (char c; reader.next(c);) {
+        if (iDecoded < sizeof(aDecoded)) {
+          aDecoded[iDecoded++] = c;
+        } else {
+          if (sLong.empty()) sLong.assign(aDecoded, iDecoded);
+          sLong += c;
+        }
+      }
+      return std::hash<std::string_view>()(
+          sLong.empty() ? std::string_view(aDecoded, iDecoded) : sLong);
+    }
+
+    // 都不含转义时直接比较原文; 否则逐字节比较解码结果, 所在对象建了
+    // 索引时先比较哈希
+    static bool sameKey(const KeyRecord& lhs, const KeyRecord& rhs) noexcept {
+      if (!lhs.bEscaped && !rhs.bEscaped) {
+        size_t size = lhs.sRaw.size();
+        return lhs.iPrefix == rhs.iPrefix && size == rhs.sRaw.size() &&
+               std::memcmp(lhs.sRaw.data(), rhs.sRaw.data(), size) == 0;
+      }
+      if (lhs.iHash != rhs.iHash) return false;
+      detail::DecodedReader left(lhs.sRaw);
+      detail::DecodedReader right(rhs.sRaw);
+      char cl = 0, cr = 0;
+      while (true) {
+        bool bLeft = left.next(cl);
+        if (bLeft != right.next(cr)) return false;
+        if (!bLeft) return true;
+        if (cl != cr) return false;
+      }
+    }
+
+    // 槽位保存键在该对象中的序号 + 1, 0 表示空; 装载率保持在 1/2 以下
+    void insertIndex(const Frame& frame, size_t pos) {
+      size_t mask = _sIndex.size() - frame.iFirstSlot - 1;
+      size_t slot = _sKeys[frame.iFirstKey + pos].iHash & mask;
+      while (_sIndex[frame.iFirstSlot + slot] != 0) slot = (slot + 1) & mask;
+      _sIndex[frame.iFirstSlot + slot] = static_cast<uint32_t>(pos + 1);
+    }
+
+    void rebuildIndex(const Frame& frame, size_t count) {
+      size_t capacity = 64;
+      while (capacity < count * 4) capacity *= 2;
+      _sIndex.resize(frame.iFirstSlot);
+      _sIndex.resize(frame.iFirstSlot + capacity, 0);
+      for (size_t i = 0; i < count; i++) {
+        KeyRecord& record = _sKeys[frame.iFirstKey + i];
+        record.iHash = hashKey(record);
+        insertIndex(frame, i);
+      }
+    }
+
+    detail::SmallStack<KeyRecord, 64> _sKeys;   // 所有未闭合对象的键
+    detail::SmallStack<Frame, 64> _sFrames;     // 未闭合的对象
+    detail::SmallStack<uint32_t, 128> _sIndex;  // 未闭合对象的哈希索引
+  };
+
+  // 不含转义的字符串直接引用输入, 否则解码到 _sScratch;
+  // 校验时不解码, 视图为引号之间的原文
+  template <class Handler>
+  bool readSaxString(std::string_view& view) {
+    const char* data = _jsonstring.data();
+    size_t start = _iIndex + 1;
+    if constexpr (std::is_same_v<Handler, ValidateHandler>) {
+      bool escaped = false;
+      JSONERROR code = detail::tryValidateString(
+          data, _jsonstring.size(), _iIndex, escaped, _iReadable);
+      if (code != JSONERROR::ERROR_NONE) {
+        fail(code, _iIndex);
+        return false;
+      }
+      view = std::string_view(data + start, _iIndex - 1 - start);
+      return true;
+    }
+    size_t end = detail::scanStringRun(data, _jsonstring.size(), start,
+                                       _iReadable);
+    if (end < _jsonstring.size() && data[end] == '\"') {
+      view = std::string_view(data + start, end - start);
+      _iIndex = end + 1;
+      return true;
+    }
+    _sScratch.clear();
+    JSONERROR code = detail::tryAppendString(
+        data, _jsonstring.size(), _iIndex, _sScratch, _iReadable);
+    if (code != JSONERROR::ERROR_NONE) {
+      fail(code, _iIndex);
+      return false;
+    }
+    view = _sScratch;
+    return true;
+  }
+
+  // handler 要求停止, 位置为最后一个事件对应的 token 之后
+  bool abortSax() {
+    fail(JSONERROR::ERROR_ABORTED, _iIndex);
+    return false;
+  }
+
+  JsonFiled::json_array newArray() const {
+    return JsonFiled::json_array(ArenaAllocator<JsonFiled>(_pArena));
+  }
+  JsonFiled::json_object newObject() const {
+    return JsonFiled::json_object(
+        ArenaAllocator<JsonFiled::json_member>(_pArena));
   }
 
-  std::string arrayToString(const json_array& array) const {
-    std::string result = "[";
-    bool first = true;
-    for (const auto& element : array) {
-      if (!first) {
-        result += ",";
-      }
-      result += element.writeToString();
-      first = false;
+  // 借用模式下尝试直接引用输入中的字符串, 失败 (需要拷贝) 时不移动 _iIndex
+  bool borrowString(std::string_view& view) {
+    if (_eStringMode == STRINGMODE::STRING_COPY) return false;
+    const char* data = _jsonstring.data();
+    size_t start = _iIndex + 1;
+    size_t end = detail::scanStringRun(data, _jsonstring.size(), start,
+                                       _iReadable);
+    if (end < _jsonstring.size() && data[end] == '\"') {  // 不含转义
+      view = std::string_view(data + start, end - start);
+      _iIndex = end + 1;
+      return true;
     }
-    result += "]";
-    return result;
-  }
-  std::string objectToString(const json_object& obj) const {
-    std::string result = "{";
-    bool first = true;
-    for (const auto& pair : obj) {
-      if (!first) {
-        result += ",";
-      }
-      result +=
-          "\"" + escapeString(pair.first) + "\":" + pair.second.writeToString();
-      first = false;
+    if (_eStringMode == STRINGMODE::STRING_INSITU) {
+      JSONERROR code = detail::tryUnescapeInPlace(
+          _pMutable, _jsonstring.size(), _iIndex, view, _iReadable);
+      if (code != JSONERROR::ERROR_NONE) fail(code, _iIndex);
+      return true;
     }
-    result += "}";
-    return result;
+    return false;
+  }
+
+  std::string parseStringValue() {
+    std::string str;
+    JSONERROR code = detail::tryAppendString(
+        _jsonstring.data(), _jsonstring.size(), _iIndex, str, _iReadable);
+    if (code != JSONERROR::ERROR_NONE) fail(code, _iIndex);
+    return str;
   }
-  friend std::ostream& operator<<(std::ostream& os, const JsonFiled& jsonField);
 
  private:
-  jValueType _jType;
-  jsonValue _jValue;
+  std::string_view _jsonstring;  // 调用方的输入, 不拷贝
+  size_t _iIndex;
+  size_t _iReadable;  // 从输入起始可安全读取的字节数 (含填充)
+  std::string _sOwned;  // 仅在接管 std::string 右值时持有输入
+  bool _bOwned{false};
+  using StructuralIndex = std::vector<uint32_t, ArenaAllocator<uint32_t>>;
+  StructuralIndex _vStructurals;  // 两阶段模式下的结构字符索引
+  size_t _iStructural{0};
+  char* _pMutable{nullptr};  // 可写输入, 仅用于原位解析
+  STRINGMODE _eStringMode{STRINGMODE::STRING_COPY};
+  JsonArena* _pArena{nullptr};
+  JsonKeyDict* _pKeyDict{nullptr};
+  bool _bLazyScalars{false};  // 见 setLazyScalars
+  size_t _iMaxDepth{64};  // 最大嵌套层数, 见 setMaxDepth
+  JSONERROR _eError{JSONERROR::ERROR_NONE};  // 本次解析的第一个错误
+  size_t _iErrorPos{0};
+  std::string _sScratch;  // SAX 解码含转义字符串的临时缓冲区, 不随拷贝传递
 };
 
-class JsonParseError : public std::exception {
+// 重载输出流操作符 friend std::ostream& operator<<(std::ostream& os, const
+// JsonFiled& jsonField);
+inline std::ostream& operator<<(std::ostream& os, const JsonFiled& jsonField) {
+  OStreamSink sink(os);
+  writeJson(jsonField, sink);
+  return os;
+}
+
+// 封装一个解析方法, 直接解析调用方的缓冲区, 不拷贝输入
+using JsonValue = JsonFiled;
+
+// 不抛异常的解析入口: 输入格式错误时返回错误码和出错的字节位置,
+// 适合含有少量坏记录的批量数据
+inline JsonResult tryParseJson(std::string_view json,
+                               PARSEMODE mode = PARSEMODE::PARSE_RECURSIVE) {
+  JsonParser parser(json);
+  return parser.tryParse(mode);
+}
+
+// 抛异常版本, 错误时抛出 JsonParseError (std::logic_error 的子类)
+inline JsonValue parserJson(std::string_view json,
+                            PARSEMODE mode = PARSEMODE::PARSE_RECURSIVE) {
+  JsonResult result = tryParseJson(json, mode);
+  if (!result) throw JsonParseError(result.error, result.offset);
+  return std::move(result.value);
+}
+inline JsonValue parserJson(const char* data, size_t len,
+                            PARSEMODE mode = PARSEMODE::PARSE_RECURSIVE) {
+  return parserJson(std::string_view(data, len), mode);
+}
+
+// 借用模式: 不含转义的字符串值和键直接引用 json, 结果树不能比 json 活得久
+inline JsonValue parserJsonBorrowed(
+    std::string_view json, PARSEMODE mode = PARSEMODE::PARSE_RECURSIVE) {
+  JsonParser parser(json);
+  parser.setStringMode(STRINGMODE::STRING_BORROW);
+  return parser.parse(mode);
+}
+
+// 延迟解码解析: 数字和字符串值只记录输入中的原文, 读取时才转换, 未修改的
+// 值序列化时原样输出, 适合只读取少量字段或原样转发的场景; 键按借用模式
+// 处理. 结果树不能比 json 活得久
+inline JsonValue parserJsonLazy(std::string_view json,
+                                PARSEMODE mode = PARSEMODE::PARSE_RECURSIVE) {
+  JsonParser parser(json);
+  parser.setLazyScalars(true);
+  parser.setStringMode(STRINGMODE::STRING_BORROW);
+  return parser.parse(mode);
+}
+
+// arena 解析: 整棵树 (节点、数组、对象、字符串) 都分配在 arena 中, 返回的根
+// 也位于 arena 内; 释放时不逐个析构节点, arena.reset() 一次回收 (O(块数))
+// 并保留内存供下次解析使用. 两阶段模式的结构索引和迭代模式的显式栈同样来自
+// arena, 任何模式下 arena 稳定后都不再调用全局 new. 树应只读使用, arena
+// reset/析构后根及其所有拷贝中的字符串全部失效
+inline const JsonValue& parserJsonArena(
+    std::string_view json, JsonArena& arena,
+    PARSEMODE mode = PARSEMODE::PARSE_RECURSIVE) {
+  JsonParser parser(json);
+  parser.setArena(&arena);
+  return *arena.create<JsonValue>(parser.parse(mode));
+}
+
+// 键驻留解析: 对象的键都驻留在 dict 中, 适合解析大量结构相同的文档;
+// 结果树不能比 dict 活得久, dict 可以在线程间共享
+inline JsonValue parserJsonInterned(
+    std::string_view json, JsonKeyDict& dict,
+    PARSEMODE mode = PARSEMODE::PARSE_RECURSIVE) {
+  JsonParser parser(json);
+  parser.setKeyDict(&dict);
+  return parser.parse(mode);
+}
+
+// SAX 解析: 不建树, 把 json 中的值作为事件交给 handler, 见
+// JsonParser::parseSax
+template <class Handler>
+inline JsonStatus parserJsonSax(std::string_view json, Handler& handler) {
+  JsonParser parser(json);
+  return parser.parseSax(handler);
+}
+
+// 只校验 json 是否合法, 不建树也不分配内存, 见 JsonParser::validate
+inline JsonStatus validateJson(std::string_view json, bool checkUtf8 = false) {
+  JsonParser parser(json);
+  return parser.validate(checkUtf8);
+}
+
+// 原位解析: 所有字符串值和键都引用 data, 含转义的字符串在 data 中原位解码
+// (会修改 data), 结果树不能比 data 活得久
+inline JsonValue parserJsonInSitu(char* data, size_t len,
+                                  PARSEMODE mode = PARSEMODE::PARSE_RECURSIVE) {
+  JsonParser parser(data, len);
+  parser.setStringMode(STRINGMODE::STRING_INSITU);
+  return parser.parse(mode);
+}
+
+class Document;
+
+// Document 中某个值的只读视图, 只保存 Document 指针与 tape 下标, 拷贝代价很低
+// Document 重新解析或析构后, 从它取得的视图和 string_view 全部失效
+class DocumentValue {
  public:
-  JsonParseError(const std::string& msg, size_t index)
-      : _msg("JSON Parse Error at index " + std::to_string(index) + ": " + msg),
-        _index(index) {}
-  const char* what() const noexcept override { return _msg.c_str(); }
-  size_t getErrorIndex() const { return _index; }
+  // 遍历数组元素或对象成员, 对象成员可以通过 key() 取得键
+  class iterator {
+   public:
+    iterator(const Document* doc, size_t index, bool isObject)
+        : _pDoc(doc), _iTape(index), _bObject(isObject) {}
+    DocumentValue operator*() const;
+    std::string_view key() const;
+    iterator& operator++();
+    bool operator==(const iterator& other) const {
+      return _iTape == other._iTape;
+    }
+    bool operator!=(const iterator& other) const { return !(*this == other); }
+
+   private:
+    const Document* _pDoc;
+    size_t _iTape;
+    bool _bObject;
+  };
+
+  DocumentValue() = default;
+
+  JSONTYPE getType() const;
+  bool isBool() const { return getType() == JSONTYPE::JSON_BOOLEAN; }
+  bool isInt() const { return getType() == JSONTYPE::JSON_NUMBER; }
+  bool isDouble() const { return getType() == JSONTYPE::JSON_DOUBLE; }
+  bool isArray() const { return getType() == JSONTYPE::JSON_ARRAY; }
+  bool isObject() const { return getType() == JSONTYPE::JSON_OBJECT; }
+  bool isString() const { return getType() == JSONTYPE::JSON_STRING; }
+  bool isNull() const { return getType() == JSONTYPE::JSON_NULL; }
+
+  int64_t asInt() const;
+  uint64_t asUInt() const;
+  double asDouble() const;
+  bool asBool() const;
+  std::string_view asString() const;
+
+  size_t size() const;
+  bool isEmpty() const { return begin() == end(); }
+  bool isMember(std::string_view key) const;
+  // 对象按键线性查找, 数组按下标顺序跳过前面的元素, 均不修改文档
+  DocumentValue operator[](std::string_view key) const;
+  DocumentValue operator[](size_t index) const;
+
+  iterator begin() const;
+  iterator end() const;
 
  private:
-  std::string _msg;
-  size_t _index;
+  friend class Document;
+  DocumentValue(const Document* doc, size_t index)
+      : _pDoc(doc), _iTape(index) {}
+  size_t findMember(std::string_view key) const;
+
+  const Document* _pDoc{nullptr};
+  size_t _iTape{0};
 };
 
-class JsonParser {
+// 以 tape 形式保存的只读 JSON 文档: 所有值按文档顺序编码在一个 64 位字数组中,
+// 所有字符串 (含对象键) 解码后依次存放在一块连续缓冲区里
+// tape 字的高 8 位为类型标记, 低 56 位为负载:
+//   'r'      根, 首字负载为末尾根字的下标
+//   '{' '['  负载低 32 位为匹配结束字之后的下标, 32~55 位为元素个数 (饱和)
+//   '}' ']'  负载为对应起始字的下标
+//   '"'      负载为字符串在缓冲区中的偏移 (4 字节长度 + 内容 + '\0')
+//   'l' 'u' 'd'  int64/uint64/double, 下一个字为数值的位模式, 'u' 只用于
+//                超出 int64 范围的非负整数
+//   't' 'f' 'n'  true/false/null
+// 解析时复用内部缓冲区, 同一个 Document 反复解析稳定后不再分配内存
+class Document {
  public:
-  explicit JsonParser(const std::string& jsonstr)
-      : _jsonstring(jsonstr), _iIndex(0) {
-    if (_jsonstring.empty()) {
-      throw std::logic_error("input JSON string is empty");
-    }
+  Document() = default;
+
+  // 解析 json, 覆盖之前的内容; 解析完成后不再引用输入. 与树解析器接受
+  // 同样的输入: 超出 double 范围的数字和同一对象中的重复键抛 JsonParseError
+  void parse(std::string_view json);
+  DocumentValue root() const { return DocumentValue(this, 1); }
+  size_t tapeSize() const { return _vTape.size(); }
+
+ private:
+  friend class DocumentValue;
+  struct Frame {
+    size_t tapeIndex;  // 容器起始字的下标
+    size_t count;      // 已解析的元素个数
+    size_t firstKey;   // 对象第一个键在 _vKeys 中的下标
+    size_t firstSlot;  // 对象的键索引在 _vKeyIndex 中的起点
+  };
+  struct KeyRecord {
+    size_t offset;  // 键在 _sStrings 中的偏移
+    size_t hash;    // 所在对象建索引后才计算
+  };
+
+  static uint64_t makeWord(char type, uint64_t payload) {
+    return (static_cast<uint64_t>(static_cast<unsigned char>(type)) << 56) |
+           payload;
   }
-  JsonParser(const JsonParser& other) {
-    _jsonstring = other._jsonstring;
-    _iIndex = other._iIndex;
+  char typeAt(size_t index) const {
+    return static_cast<char>(_vTape[index] >> 56);
   }
-  JsonParser& operator=(const JsonParser& other) {
-    if (this != &other) {
-      _jsonstring = other._jsonstring;
-      _iIndex = other._iIndex;
-    }
-    return *this;
+  uint64_t payloadAt(size_t index) const {
+    return _vTape[index] & 0x00FFFFFFFFFFFFFFULL;
   }
-  JsonParser(JsonParser&& other) {
-    _jsonstring = std::move(other._jsonstring);
-    _iIndex = other._iIndex;
+  // 跳过 index 处的值, 返回其后一个值的下标
+  size_t skipValue(size_t index) const {
+    char type = typeAt(index);
+    if (type == '{' || type == '[') return payloadAt(index) & 0xFFFFFFFFULL;
+    if (type == 'l' || type == 'u' || type == 'd') return index + 2;
+    return index + 1;
   }
-  JsonParser& operator=(JsonParser&& other) {
-    if (this != &other) {
-      _jsonstring = std::move(other._jsonstring);
-      _iIndex = other._iIndex;
-    }
-    return *this;
+  std::string_view stringAt(size_t index) const {
+    return stringAtOffset(payloadAt(index));
+  }
+  std::string_view stringAtOffset(size_t offset) const {
+    uint32_t len;
+    std::memcpy(&len, _sStrings.data() + offset, sizeof(len));
+    return std::string_view(_sStrings.data() + offset + sizeof(len), len);
   }
-  ~JsonParser() = default;
-
- public:
-  JsonFiled parser(size_t CurrentDepth = 0) {
-    if (CurrentDepth > _iMaxDepth) {
-      throw JsonParseError("Maximum JSON depth exceeded", CurrentDepth);
-    }
 
-    char sToken = getNextToken();
+  void writeString(const char* data, size_t len, size_t& pos) {
+    size_t offset = _sStrings.size();
+    _sStrings.append(sizeof(uint32_t), '\0');  // 长度占位, 解码后回填
+    detail::appendString(data, len, pos, _sStrings);
+    uint32_t strLen =
+        static_cast<uint32_t>(_sStrings.size() - offset - sizeof(uint32_t));
+    std::memcpy(&_sStrings[offset], &strLen, sizeof(strLen));
+    _sStrings.push_back('\0');
+    _vTape.push_back(makeWord('"', offset));
+  }
 
-    // 根据当前字符分辨 JSON 类型
-    if (sToken == 'n') return parseNull();                      // null
-    if (sToken == 't' || sToken == 'f') return parseBoolean();  // true/false
-    if (sToken == '-' || std::isdigit(sToken)) return parseNumber();  // 数字
-    if (sToken == '\"') return parseString();                 // 字符串
-    if (sToken == '[') return parseArray(CurrentDepth + 1);   // 数组
-    if (sToken == '{') return parseObject(CurrentDepth + 1);  // 对象
-    throw JsonParseError(std::string("Invalid JSON character: ") + sToken,
-                         CurrentDepth);
+  void writeScalar(const char* data, size_t len, size_t& pos) {
+    char c = data[pos];
+    if (c == '"') {
+      writeString(data, len, pos);
+    } else if (c == 't' && len - pos >= 4 &&
+               !std::memcmp(data + pos, "true", 4)) {
+      _vTape.push_back(makeWord('t', 0));
+      pos += 4;
+    } else if (c == 'f' && len - pos >= 5 &&
+               !std::memcmp(data + pos, "false", 5)) {
+      _vTape.push_back(makeWord('f', 0));
+      pos += 5;
+    } else if (c == 'n' && len - pos >= 4 &&
+               !std::memcmp(data + pos, "null", 4)) {
+      _vTape.push_back(makeWord('n', 0));
+      pos += 4;
+    } else if (c == '-' || (c >= '0' && c <= '9')) {
+      bool negative = c == '-';
+      size_t end = pos + (negative ? 1 : 0);
+      uint64_t magnitude = 0;
+      if (detail::tryParseIntegerPart(data, len, end, magnitude) ==
+              JSONERROR::ERROR_NONE &&
+          !detail::isFloatTail(data, len, end)) {
+        if (!negative || magnitude <= static_cast<uint64_t>(INT64_MAX) + 1) {
+          bool isUInt = !negative && magnitude > INT64_MAX;
+          _vTape.push_back(makeWord(isUInt ? 'u' : 'l', 0));
+          _vTape.push_back(negative ? 0 - magnitude : magnitude);
+          pos = end;
+          return;
+        }
+      }  // 浮点数和超出 64 位范围的整数按 double 存储
+      const size_t start = pos;
+      double value = 0;
+      JSONERROR code = detail::tryParseDouble(data, len, pos, value);
+      if (code == JSONERROR::ERROR_NUMBER_OUT_OF_RANGE) {
+        throw JsonParseError(code, start);
+      }
+      if (code != JSONERROR::ERROR_NONE) throw JsonParseError(code, pos);
+      uint64_t bits;
+      std::memcpy(&bits, &value, sizeof(bits));
+      _vTape.push_back(makeWord('d', 0));
+      _vTape.push_back(bits);
+    } else {
+      throw JsonParseError(std::string("Invalid JSON character: ") + c, pos);
+    }
   }
 
- private:
-  char getNextToken() {
-    while (std::isspace(_jsonstring[_iIndex])) {
-      _iIndex++;
+  // 与 BasicJsonObject 相同: 键较少时线性比较, 超过 INDEX_THRESHOLD 个后
+  // 为所在对象建开放寻址索引. 只有最内层的对象会新增键, 所以各未闭合对象
+  // 的键和索引共用 _vKeys 与 _vKeyIndex 两个栈
+  bool addKey(Frame& frame, size_t offset) {
+    KeyRecord record{offset, 0};
+    std::string_view key = stringAtOffset(offset);
+    const size_t slots = _vKeyIndex.size() - frame.firstSlot;
+    if (slots == 0) {
+      for (size_t i = frame.firstKey; i < _vKeys.size(); i++) {
+        if (stringAtOffset(_vKeys[i].offset) == key) return false;
+      }
+    } else {
+      record.hash = std::hash<std::string_view>()(key);
+      size_t mask = slots - 1;
+      for (size_t slot = record.hash & mask;; slot = (slot + 1) & mask) {
+        uint32_t entry = _vKeyIndex[frame.firstSlot + slot];
+        if (entry == 0) break;
+        const KeyRecord& other = _vKeys[frame.firstKey + entry - 1];
+        if (other.hash == record.hash && stringAtOffset(other.offset) == key)
+          return false;
+      }
     }
-    if (_iIndex >= _jsonstring.size()) {
-      throw std::logic_error("unexpected character in parse json");
+    _vKeys.push_back(record);
+    const size_t count = _vKeys.size() - frame.firstKey;
+    if (slots != 0 && count * 2 <= slots) {
+      insertKeyIndex(frame, count - 1);
+    } else if (count > JsonFiled::json_object::INDEX_THRESHOLD) {
+      size_t capacity = 64;
+      while (capacity < count * 4) capacity *= 2;
+      _vKeyIndex.resize(frame.firstSlot);
+      _vKeyIndex.resize(frame.firstSlot + capacity, 0);
+      for (size_t i = 0; i < count; i++) {
+        KeyRecord& key = _vKeys[frame.firstKey + i];
+        key.hash = std::hash<std::string_view>()(stringAtOffset(key.offset));
+        insertKeyIndex(frame, i);
+      }
     }
-    return _jsonstring[_iIndex];
+    return true;
+  }
+  // 槽位保存键在该对象中的序号 + 1, 0 表示空; 装载率保持在 1/2 以下
+  void insertKeyIndex(const Frame& frame, size_t pos) {
+    size_t mask = _vKeyIndex.size() - frame.firstSlot - 1;
+    size_t slot = _vKeys[frame.firstKey + pos].hash & mask;
+    while (_vKeyIndex[frame.firstSlot + slot] != 0) slot = (slot + 1) & mask;
+    _vKeyIndex[frame.firstSlot + slot] = static_cast<uint32_t>(pos + 1);
   }
 
-  JsonFiled parseNull() {
-    // 直接比较 jsonstring 从 index 开始的 4 个字符是否为 "null"
-    if (_jsonstring.compare(_iIndex, 4, "null") == 0) {
-      _iIndex += 4;  // 移动索引，跳过 "null"
-      return JsonFiled();
-    }
-    throw std::logic_error("parse null error");
+  void closeContainer(char close) {
+    Frame frame = _vStack.back();
+    _vStack.pop_back();
+    _vKeys.resize(frame.firstKey);
+    _vKeyIndex.resize(frame.firstSlot);
+    uint64_t count = frame.count < 0xFFFFFF ? frame.count : 0xFFFFFF;
+    size_t closeIndex = _vTape.size();
+    _vTape[frame.tapeIndex] =
+        makeWord(typeAt(frame.tapeIndex), (count << 32) | (closeIndex + 1));
+    _vTape.push_back(makeWord(close, frame.tapeIndex));
   }
-  JsonFiled parseBoolean() {
-    // 比较 jsonstring 从 index 开始的 4 个字符是否为 "true"
-    if (_jsonstring.compare(_iIndex, 4, "true") == 0) {
-      _iIndex += 4;  // 移动索引，跳过 "true"
-      return JsonFiled(true);
+
+ private:
+  std::vector<uint64_t> _vTape;
+  std::string _sStrings;
+  std::vector<uint32_t> _vStructurals;
+  std::vector<Frame> _vStack;
+  std::vector<KeyRecord> _vKeys;     // 所有未闭合对象的键
+  std::vector<uint32_t> _vKeyIndex;  // 未闭合对象的键索引
+  constexpr static size_t _iMaxDepth{1024};
+};
+
+inline void Document::parse(std::string_view json) {
+  _vTape.clear();
+  _sStrings.clear();
+  _vStack.clear();
+  _vKeys.clear();
+  _vKeyIndex.clear();
+  const char* data = json.data();
+  const size_t len = json.size();
+  if (len == 0) {
+    throw std::logic_error("input JSON string is empty");
+  }
+  if (len > UINT32_MAX) {
+    throw JsonParseError("input too large for structural index", UINT32_MAX);
+  }
+  if (!detail::buildStructuralIndex(data, len, _vStructurals)) {
+    throw JsonParseError("unterminated string in JSON", len);
+  }
+  const uint32_t* indexes = _vStructurals.data();
+  const size_t count = _vStructurals.size();
+  size_t i = 0;
+  auto next = [&]() -> size_t {
+    if (i >= count) throw JsonParseError("Unexpected end of input", len);
+    return indexes[i++];
+  };
+  // 标量必须恰好结束在下一个结构字符之前 (中间只允许空白)
+  auto checkScalarEnd = [&](size_t end) {
+    size_t limit = i < count ? indexes[i] : len;
+    if (detail::skipWhitespace(data, limit, end) != limit) {
+      throw JsonParseError("Invalid character after JSON value", end);
     }
-    // 比较 jsonstring 从 index 开始的 5 个字符是否为 "false"
-    if (_jsonstring.compare(_iIndex, 5, "false") == 0) {
-      _iIndex += 5;  // 移动索引，跳过 "false"
-      return JsonFiled(false);
+  };
+  auto parseKey = [&]() {
+    size_t pos = next();
+    if (data[pos] != '"') {
+      throw JsonParseError("Expected string key in object", pos);
     }
-    throw std::logic_error("parse bool error");
-  }
+    const size_t keyPos = pos;
+    writeString(data, len, pos);
+    if (!addKey(_vStack.back(), payloadAt(_vTape.size() - 1))) {
+      throw JsonParseError(JSONERROR::ERROR_DUPLICATE_KEY, keyPos);
+    }
+    checkScalarEnd(pos);
+    pos = next();
+    if (data[pos] != ':') {
+      throw JsonParseError(
+          "Expected ':' in object, but found: " + std::string(1, data[pos]),
+          pos);
+    }
+  };
 
-  JsonFiled parseNumber() {
-    int pos = _iIndex;                           // 记录起始位置
-    if (_jsonstring[_iIndex] == '-') _iIndex++;  // 跳过负号
-
-    // 整数部分
-    if (_iIndex >= _jsonstring.size() || !std::isdigit(_jsonstring[_iIndex])) {
-      throw std::logic_error("Invalid character in number");
-    }
-    while (_iIndex < _jsonstring.size() && std::isdigit(_jsonstring[_iIndex])) {
-      _iIndex++;
-    }
-    // 小数部分
-    if (_iIndex < _jsonstring.size() && _jsonstring[_iIndex] == '.') {
-      _iIndex++;
-      if (_iIndex >= _jsonstring.size() ||
-          !std::isdigit(_jsonstring[_iIndex])) {
-        throw std::logic_error(
-            "At least one digit required after decimal point");
-      }
-      while (_iIndex < _jsonstring.size() &&
-             std::isdigit(_jsonstring[_iIndex])) {
-        _iIndex++;
+  _vTape.push_back(makeWord('r', 0));
+  size_t pos = next();
+  while (true) {
+    // 解析一个值
+    char c = data[pos];
+    if (c == '{' || c == '[') {
+      if (_vStack.size() >= _iMaxDepth) {
+        throw JsonParseError("Maximum JSON depth exceeded", pos);
+      }
+      char close = c == '{' ? '}' : ']';
+      _vStack.push_back(
+          Frame{_vTape.size(), 0, _vKeys.size(), _vKeyIndex.size()});
+      _vTape.push_back(makeWord(c, 0));
+      if (i < count && data[indexes[i]] == close) {
+        i++;  // 空容器
+        closeContainer(close);
+      } else {
+        if (c == '{') parseKey();
+        pos = next();
+        continue;
       }
+    } else {
+      writeScalar(data, len, pos);
+      checkScalarEnd(pos);
     }
-    // 科学计数法部分
-    if (_iIndex < _jsonstring.size() &&
-        (_jsonstring[_iIndex] == 'e' || _jsonstring[_iIndex] == 'E')) {
-      _iIndex++;
-      if (_iIndex < _jsonstring.size() &&
-          (_jsonstring[_iIndex] == '+' || _jsonstring[_iIndex] == '-')) {
-        _iIndex++;
+    // 值结束后处理所在容器的分隔符或结束符
+    while (true) {
+      if (_vStack.empty()) {
+        if (i != count) {
+          throw JsonParseError("Unexpected content after JSON value",
+                               indexes[i]);
+        }
+        _vTape[0] = makeWord('r', _vTape.size());
+        _vTape.push_back(makeWord('r', 0));
+        return;
       }
-      if (_iIndex >= _jsonstring.size() ||
-          !std::isdigit(_jsonstring[_iIndex])) {
-        throw std::logic_error(
-            "At least one digit required in scientific notation exponent");
+      Frame& frame = _vStack.back();
+      frame.count++;
+      bool isObject = typeAt(frame.tapeIndex) == '{';
+      char close = isObject ? '}' : ']';
+      pos = next();
+      if (data[pos] == ',') {
+        if (isObject) parseKey();
+        pos = next();
+        break;
       }
-      while (_iIndex < _jsonstring.size() &&
-             std::isdigit(_jsonstring[_iIndex])) {
-        _iIndex++;
+      if (data[pos] != close) {
+        throw JsonParseError(std::string("Expected ',' or '") + close +
+                                 "', but found: " + data[pos],
+                             pos);
       }
-    }
-    // 解析部分完成后进行最终转换
-    std::string_view numberString{_jsonstring.c_str() + pos,
-                                  static_cast<size_t>(_iIndex - pos)};
-    if (numberString.find('.') != std::string_view::npos ||
-        numberString.find('e') != std::string_view::npos ||
-        numberString.find('E') != std::string_view::npos) {
-      return JsonFiled(std::stof(std::string(numberString)));  // 浮点数
-    } else {
-      return JsonFiled(std::stoi(std::string(numberString)));  // 整数
+      closeContainer(close);
     }
   }
+}
 
-  JsonFiled parseString() {
-    std::string str;
-    _iIndex++;  // 跳过起始引号 '\"'
-    while (_iIndex < _jsonstring.size() && _jsonstring[_iIndex] != '\"') {
-      if (_jsonstring[_iIndex] == '\\') {  // 检测转义字符
-        _iIndex++;
-        if (_iIndex >= _jsonstring.size()) {
-          throw std::logic_error("unterminated string in JSON");
-        }
-        switch (_jsonstring[_iIndex]) {
-          case 'n':
-            str += '\n';
-            break;
-          case 't':
-            str += '\t';
-            break;
-          case 'r':
-            str += '\r';
-            break;
-          case '\"':
-            str += '\"';
-            break;
-          case '\\':
-            str += '\\';
-            break;
-          default:
-            throw std::logic_error("invalid escape character in string");
-        }
-      } else {
-        str += _jsonstring[_iIndex];
-      }
-      _iIndex++;
-    }
-    if (_jsonstring[_iIndex] != '\"') {
-      throw std::logic_error("unterminated string in JSON");
+inline JSONTYPE DocumentValue::getType() const {
+  switch (_pDoc->typeAt(_iTape)) {
+    case '{':
+      return JSONTYPE::JSON_OBJECT;
+    case '[':
+      return JSONTYPE::JSON_ARRAY;
+    case '"':
+      return JSONTYPE::JSON_STRING;
+    case 'l':
+    case 'u':
+      return JSONTYPE::JSON_NUMBER;
+    case 'd':
+      return JSONTYPE::JSON_DOUBLE;
+    case 't':
+    case 'f':
+      return JSONTYPE::JSON_BOOLEAN;
+    default:
+      return JSONTYPE::JSON_NULL;
+  }
+}
+
+inline int64_t DocumentValue::asInt() const {
+  if (!isInt()) throw std::logic_error("Cannot convert to int, invalid type");
+  if (_pDoc->typeAt(_iTape) == 'u')
+    throw std::logic_error("JSON integer out of int64 range");
+  return static_cast<int64_t>(_pDoc->_vTape[_iTape + 1]);
+}
+
+inline uint64_t DocumentValue::asUInt() const {
+  if (!isInt()) throw std::logic_error("Cannot convert to int, invalid type");
+  uint64_t value = _pDoc->_vTape[_iTape + 1];
+  if (_pDoc->typeAt(_iTape) == 'l' && static_cast<int64_t>(value) < 0)
+    throw std::logic_error("negative JSON integer as uint64");
+  return value;
+}
+
+inline double DocumentValue::asDouble() const {
+  if (!isDouble())
+    throw std::logic_error("Cannot convert to double, invalid type");
+  double value;
+  std::memcpy(&value, &_pDoc->_vTape[_iTape + 1], sizeof(value));
+  return value;
+}
+
+inline bool DocumentValue::asBool() const {
+  if (!isBool()) throw std::logic_error("Cannot convert to bool, invalid type");
+  return _pDoc->typeAt(_iTape) == 't';
+}
+
+inline std::string_view DocumentValue::asString() const {
+  if (!isString())
+    throw std::logic_error("Cannot convert to string, invalid type");
+  return _pDoc->stringAt(_iTape);
+}
+
+inline size_t DocumentValue::size() const {
+  if (!isArray() && !isObject())
+    throw std::logic_error("Cannot get size, invalid type");
+  size_t count = _pDoc->payloadAt(_iTape) >> 32;
+  if (count < 0xFFFFFF) return count;
+  count = 0;  // 元素个数超出计数范围时逐个统计
+  for (iterator it = begin(); it != end(); ++it) count++;
+  return count;
+}
+
+inline size_t DocumentValue::findMember(std::string_view key) const {
+  if (!isObject()) return 0;
+  size_t endIndex = (_pDoc->payloadAt(_iTape) & 0xFFFFFFFFULL) - 1;
+  for (size_t i = _iTape + 1; i < endIndex; i = _pDoc->skipValue(i + 1)) {
+    if (_pDoc->stringAt(i) == key) return i + 1;
+  }
+  return 0;
+}
+
+inline bool DocumentValue::isMember(std::string_view key) const {
+  return findMember(key) != 0;
+}
+
+inline DocumentValue DocumentValue::operator[](std::string_view key) const {
+  if (!isObject())
+    throw std::logic_error("Current object is not k-v obj, invalid type");
+  size_t index = findMember(key);
+  if (index == 0) throw std::logic_error("Key not found in JSON object.");
+  return DocumentValue(_pDoc, index);
+}
+
+inline DocumentValue DocumentValue::operator[](size_t index) const {
+  if (!isArray())
+    throw std::logic_error("Current obj is not a array, invalid index type");
+  for (iterator it = begin(); it != end(); ++it, --index) {
+    if (index == 0) return *it;
+  }
+  throw std::logic_error("Index out of range for JSON array.");
+}
+
+inline DocumentValue::iterator DocumentValue::begin() const {
+  if (!isArray() && !isObject())
+    throw std::logic_error("Cannot iterate, invalid type");
+  return iterator(_pDoc, _iTape + 1, isObject());
+}
+
+inline DocumentValue::iterator DocumentValue::end() const {
+  if (!isArray() && !isObject())
+    throw std::logic_error("Cannot iterate, invalid type");
+  return iterator(_pDoc, (_pDoc->payloadAt(_iTape) & 0xFFFFFFFFULL) - 1,
+                  isObject());
+}
+
+// 对象成员的迭代位置指向键, 值紧随其后
+inline DocumentValue DocumentValue::iterator::operator*() const {
+  return DocumentValue(_pDoc, _bObject ? _iTape + 1 : _iTape);
+}
+
+inline std::string_view DocumentValue::iterator::key() const {
+  if (!_bObject) throw std::logic_error("Array element has no key");
+  return _pDoc->stringAt(_iTape);
+}
+
+inline DocumentValue::iterator& DocumentValue::iterator::operator++() {
+  _iTape = _pDoc->skipValue(_bObject ? _iTape + 1 : _iTape);
+  return *this;
+}
+
+// 按需解析: 直接在调用方的缓冲区上导航, 只解码实际访问到的键和值,
+// 路径之外的值只做括号与字符串边界匹配后跳过, 不分配内存, 也不做完整校验
+// LazyValue 只是 (缓冲区, 位置) 的视图, 缓冲区在使用期间必须保持有效且不被修改
+class LazyValue {
+ public:
+  LazyValue() = default;
+  explicit LazyValue(std::string_view json)
+      : _pData(json.data()), _iLen(json.size()) {
+    _iPos = detail::skipWhitespace(_pData, _iLen, 0);
+    if (_iPos >= _iLen) {
+      throw std::logic_error("input JSON string is empty");
     }
-    _iIndex++;  // 跳过最后的引号 '\"'
-    return JsonFiled(std::move(str));
   }
 
-  JsonFiled parseArray(size_t CurrentDepth) {
-    JsonFiled::json_array vJvalue;
-    _iIndex++;  // 跳过 '['
-    if (_iIndex >= _jsonstring.size()) {
-      throw JsonParseError("Unexpected end of input during array parsing",
-                           CurrentDepth);
+  JSONTYPE getType() const {
+    char c = _pData[_iPos];
+    if (c == '{') return JSONTYPE::JSON_OBJECT;
+    if (c == '[') return JSONTYPE::JSON_ARRAY;
+    if (c == '"') return JSONTYPE::JSON_STRING;
+    if (c == 't' || c == 'f') return JSONTYPE::JSON_BOOLEAN;
+    if (c == 'n') return JSONTYPE::JSON_NULL;
+    if (c == '-' || (c >= '0' && c <= '9')) {
+      size_t pos = _iPos;
+      return detail::scanNumber(_pData, _iLen, pos) ? JSONTYPE::JSON_DOUBLE
+                                                    : JSONTYPE::JSON_NUMBER;
     }
-    if (_jsonstring[_iIndex] == ']') {
-      _iIndex++;                             // 跳过 ']'
-      return JsonFiled(std::move(vJvalue));  // 空数组
+    throw JsonParseError(std::string("Invalid JSON character: ") + c, _iPos);
+  }
+  bool isBool() const { return getType() == JSONTYPE::JSON_BOOLEAN; }
+  bool isInt() const { return getType() == JSONTYPE::JSON_NUMBER; }
+  bool isDouble() const { return getType() == JSONTYPE::JSON_DOUBLE; }
+  bool isArray() const { return getType() == JSONTYPE::JSON_ARRAY; }
+  bool isObject() const { return getType() == JSONTYPE::JSON_OBJECT; }
+  bool isString() const { return getType() == JSONTYPE::JSON_STRING; }
+  bool isNull() const { return getType() == JSONTYPE::JSON_NULL; }
+
+  int64_t asInt() const {
+    if (!isInt()) throw std::logic_error("Cannot convert to int, invalid type");
+    int64_t value = 0;
+    size_t end = _iPos;
+    detail::scanNumber(_pData, _iLen, end);
+    auto res = std::from_chars(_pData + _iPos, _pData + end, value);
+    if (res.ec != std::errc()) {
+      throw std::out_of_range("JSON integer out of int64 range");
     }
-    while (true) {
-      if (_iIndex >= _jsonstring.size()) {
-        throw JsonParseError("Unexpected end of input during array parsing",
-                             CurrentDepth);
-      }
-      vJvalue.push_back(std::move(parser(CurrentDepth + 1)));
-      char ch = getNextToken();
-      if (ch == ']') {
-        _iIndex++;  // 跳过 ']'
-        return JsonFiled(std::move(vJvalue));
-      }
-      if (ch != ',') {
-        throw JsonParseError(
-            "Expected ',' or ']' in array, but found: " + std::string(1, ch),
-            CurrentDepth);
-      }
-      _iIndex++;  // 跳过 ',' 分隔符
+    return value;
+  }
+  uint64_t asUInt() const {
+    if (!isInt()) throw std::logic_error("Cannot convert to int, invalid type");
+    uint64_t value = 0;
+    size_t end = _iPos;
+    detail::scanNumber(_pData, _iLen, end);
+    auto res = std::from_chars(_pData + _iPos, _pData + end, value);
+    if (res.ec != std::errc()) {
+      throw std::out_of_range("JSON integer out of uint64 range");
     }
+    return value;
+  }
+  double asDouble() const {
+    if (!isDouble())
+      throw std::logic_error("Cannot convert to double, invalid type");
+    size_t end = _iPos;
+    return detail::parseDouble(_pData, _iLen, end);
+  }
+  bool asBool() const {
+    if (matchLiteral("true")) return true;
+    if (matchLiteral("false")) return false;
+    throw std::logic_error("Cannot convert to bool, invalid type");
+  }
+  // 解码转义后返回字符串, 只有这里会分配内存
+  std::string asString() const {
+    if (!isString())
+      throw std::logic_error("Cannot convert to string, invalid type");
+    std::string str;
+    size_t pos = _iPos;
+    detail::appendString(_pData, _iLen, pos, str);
+    return str;
+  }
+  // 值的原始字节 (字符串包含引号), 可以不经解码直接转发
+  std::string_view getRaw() const {
+    size_t end = detail::skipValue(_pData, _iLen, _iPos);
+    return std::string_view(_pData + _iPos, end - _iPos);
   }
 
-  JsonFiled parseObject(size_t currentDepth) {
-    JsonFiled::json_object mJvalue;
-    _iIndex++;  // 跳过 '{'
-    if (_iIndex >= _jsonstring.size()) {
-      throw JsonParseError("Unexpected end of input during object parsing",
-                           currentDepth);
-    }
-    if (getNextToken() == '}') {
-      _iIndex++;                             // 跳过 '}'
-      return JsonFiled(std::move(mJvalue));  // 空对象
+  size_t size() const {
+    if (!isArray() && !isObject())
+      throw std::logic_error("Cannot get size, invalid type");
+    size_t count = 0;
+    for (size_t pos = firstElement(); pos != std::string_view::npos;
+         pos = nextElement(pos)) {
+      count++;
     }
-    while (true) {
-      if (_iIndex >= _jsonstring.size()) {
-        throw JsonParseError("Unexpected end of input during object parsing",
-                             currentDepth);
-      }
-      std::string sKey =
-          std::move(parser(currentDepth + 1).get<JsonFiled::json_string>());
-      char ch = getNextToken();
-      if (ch != ':') {
-        throw JsonParseError(
-            "Expected ':' in object, but found: " + std::string(1, ch),
-            currentDepth);
-      }
-      _iIndex++;  // 跳过 ':'
-      if (mJvalue.find(sKey) != mJvalue.end()) {
-        throw JsonParseError("duplicate key in JSON object", currentDepth);
-      }
-      mJvalue[sKey] = parser(currentDepth + 1);
-      ch = getNextToken();
-      if (ch == '}') {
-        _iIndex++;  // 跳过 '}'
-        return JsonFiled(std::move(mJvalue));
-      }
-      if (ch != ',') {
-        throw JsonParseError(
-            "Expected ',' or '}' in object, but found: " + std::string(1, ch),
-            currentDepth);
-      }
-      _iIndex++;  // 跳过 ',' 分隔符
+    return count;
+  }
+  bool isMember(std::string_view key) const {
+    return isObject() && findMember(key) != std::string_view::npos;
+  }
+  LazyValue operator[](std::string_view key) const {
+    if (!isObject())
+      throw std::logic_error("Current object is not k-v obj, invalid type");
+    size_t pos = findMember(key);
+    if (pos == std::string_view::npos)
+      throw std::logic_error("Key not found in JSON object.");
+    return LazyValue(_pData, _iLen, pos);
+  }
+  LazyValue operator[](size_t index) const {
+    if (!isArray())
+      throw std::logic_error("Current obj is not a array, invalid index type");
+    for (size_t pos = firstElement(); pos != std::string_view::npos;
+         pos = nextElement(pos), --index) {
+      if (index == 0) return LazyValue(_pData, _iLen, pos);
     }
+    throw std::logic_error("Index out of range for JSON array.");
   }
 
  private:
-  std::string _jsonstring;
-  size_t _iIndex;
-  constexpr static size_t _iMaxDepth{64};  // 暂定写死
-};
+  LazyValue(const char* data, size_t len, size_t pos)
+      : _pData(data), _iLen(len), _iPos(pos) {}
 
-// 重载输出流操作符 friend std::ostream& operator<<(std::ostream& os, const
-// JsonFiled& jsonField);
-inline std::ostream& operator<<(std::ostream& os, const JsonFiled& jsonField) {
-  os << jsonField.writeToString();
-  return os;
-}
+  bool matchLiteral(std::string_view literal) const {
+    return _iLen - _iPos >= literal.size() &&
+           std::memcmp(_pData + _iPos, literal.data(), literal.size()) == 0;
+  }
+  size_t skipSpace(size_t pos) const {
+    return detail::skipWhitespace(_pData, _iLen, pos);
+  }
 
-// 封装一个解析方法
-using JsonValue = JsonFiled;
-inline JsonValue parserJson(const std::string& jsonstr) {
-  JsonParser parser(jsonstr);
-  return parser.parser();
-}
+  // 比较 pos 处 (指向起始引号) 的键, pos 移到 ':' 之后的值上
+  bool readKey(size_t& pos, std::string_view key) const {
+    if (pos >= _iLen || _pData[pos] != '"') {
+      throw JsonParseError("Expected string key in object", pos);
+    }
+    bool match;
+    size_t end = detail::scanStringRun(_pData, _iLen, pos + 1);
+    if (end < _iLen && _pData[end] == '"') {  // 不含转义的键直接比较原始字节
+      match = end - pos - 1 == key.size() &&
+              (key.empty() ||
+               std::memcmp(_pData + pos + 1, key.data(), key.size()) == 0);
+      pos = end + 1;
+    } else if (detail::tryMatchString(_pData, _iLen, pos, key, match) !=
+               JSONERROR::ERROR_NONE) {
+      throw std::logic_error("invalid or unterminated string in JSON");
+    }
+    pos = skipSpace(pos);
+    if (pos >= _iLen || _pData[pos] != ':') {
+      throw JsonParseError("Expected ':' in object", pos);
+    }
+    pos = skipSpace(pos + 1);
+    if (pos >= _iLen) throw JsonParseError("Unexpected end of input", pos);
+    return match;
+  }
 
-// 一个输出所有解析完成后的json字段的方法
-void PrintJson(const yoyo::JsonFiled& jsonField, int indent = 0) {
-  // 打印缩进
-  auto printIndent = [&]() {
-    for (int i = 0; i < indent; ++i) std::cout << "  ";
-  };
-  // 识别 JSON 值的类型
-  switch (jsonField.getType()) {
-    case yoyo::JSONTYPE::JSON_NULL:
-      printIndent();
-      std::cout << "null" << std::endl;
-      break;
-    case yoyo::JSONTYPE::JSON_BOOLEAN:
-      printIndent();
-      std::cout << (jsonField.get<yoyo::JsonFiled::json_bool>() ? "true"
-                                                                : "false")
-                << std::endl;
-      break;
-    case yoyo::JSONTYPE::JSON_NUMBER:
-      printIndent();
-      std::cout << jsonField.get<yoyo::JsonFiled::json_int>() << std::endl;
-      break;
-    case yoyo::JSONTYPE::JSON_DOUBLE:
-      printIndent();
-      std::cout << jsonField.get<yoyo::JsonFiled::json_double>() << std::endl;
-      break;
-    case yoyo::JSONTYPE::JSON_STRING:
-      printIndent();
-      std::cout << "\"" << jsonField.get<yoyo::JsonFiled::json_string>() << "\""
-                << std::endl;
-      break;
-    case yoyo::JSONTYPE::JSON_ARRAY: {
-      printIndent();
-      std::cout << "[" << std::endl;
-      for (const auto& item : jsonField.get<yoyo::JsonFiled::json_array>()) {
-        PrintJson(item, indent + 1);  // 递归打印数组的每个元素
-      }
-      printIndent();
-      std::cout << "]" << std::endl;
-      break;
-    }
-    case yoyo::JSONTYPE::JSON_OBJECT: {
-      printIndent();
-      std::cout << "{" << std::endl;
-      for (const auto& [key, value] :
-           jsonField.get<yoyo::JsonFiled::json_object>()) {
-        printIndent();
-        std::cout << "\"" << key << "\": ";
-        PrintJson(value, indent + 1);  // 递归打印对象的每个字段
-      }
-      printIndent();
-      std::cout << "}" << std::endl;
-      break;
+  // 返回第一个元素 (对象则为第一个键) 的位置, 空容器返回 npos
+  size_t firstElement() const {
+    size_t pos = skipSpace(_iPos + 1);
+    if (pos < _iLen && (_pData[pos] == ']' || _pData[pos] == '}'))
+      return std::string_view::npos;
+    return pos;
+  }
+  // 跳过 pos 处的元素 (对象则为整个键值对), 返回下一个元素的位置或 npos
+  size_t nextElement(size_t pos) const {
+    if (_pData[_iPos] == '{') readKey(pos, std::string_view());
+    pos = skipSpace(detail::skipValue(_pData, _iLen, pos));
+    if (pos < _iLen && _pData[pos] == ',') return skipSpace(pos + 1);
+    if (pos < _iLen && (_pData[pos] == ']' || _pData[pos] == '}'))
+      return std::string_view::npos;
+    throw JsonParseError("Expected ',' or end of container", pos);
+  }
+  // 查找键对应值的位置, 不存在返回 npos
+  size_t findMember(std::string_view key) const {
+    for (size_t pos = firstElement(); pos != std::string_view::npos;) {
+      size_t valuePos = pos;
+      if (readKey(valuePos, key)) return valuePos;
+      pos = skipSpace(detail::skipValue(_pData, _iLen, valuePos));
+      if (pos < _iLen && _pData[pos] == ',') {
+        pos = skipSpace(pos + 1);
+      } else if (pos < _iLen && _pData[pos] == '}') {
+        break;
+      } else {
+        throw JsonParseError("Expected ',' or '}' in object", pos);
+      }
     }
-    default:
-      throw std::logic_error("Unknown JSON type.");
+    return std::string_view::npos;
   }
+
+ private:
+  const char* _pData{nullptr};
+  size_t _iLen{0};
+  size_t _iPos{0};
+};
+
+// 格式化输出到 std::cout, 用于调试; indent 为起始缩进层数.
+// 整个文档写完后才刷新一次
+inline void PrintJson(const yoyo::JsonFiled& jsonField, int indent = 0) {
+  JsonWriteOptions options;
+  options.pretty = true;
+  std::string out(static_cast<size_t>(indent) * options.indentWidth, ' ');
+  StringSink sink(out);
+  JsonWriter<StringSink>(sink, options).write(jsonField,
+                                              static_cast<size_t>(indent));
+  out += '\n';
+  std::cout.write(out.data(), static_cast<std::streamsize>(out.size()));
+  std::cout.flush();
 }
 
 }  // namespace yoyo
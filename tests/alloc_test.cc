@@ -0,0 +1,94 @@
+// 统计全局 operator new 调用次数的测试, 需要替换全局分配函数,
+// 因此与 unit_test.cc 分开编译为独立的可执行文件
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <sstream>
+#include <string>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../src/json_parser.hpp"
+#include "./doctest.h"
+
+// 替换函数不能内联, 否则编译器会把内联后的 free 与 new 配对误报
+// -Wmismatched-new-delete
+#if defined(_MSC_VER)
+#define YOYO_NOINLINE __declspec(noinline)
+#else
+#define YOYO_NOINLINE __attribute__((noinline))
+#endif
+
+static size_t g_iNewCalls = 0;
+
+YOYO_NOINLINE void* operator new(std::size_t size) {
+  ++g_iNewCalls;
+  if (void* p = std::malloc(size ? size : 1)) return p;
+  throw std::bad_alloc();
+}
+YOYO_NOINLINE void* operator new[](std::size_t size) {
+  return ::operator new(size);
+}
+YOYO_NOINLINE void operator delete(void* p) noexcept { std::free(p); }
+YOYO_NOINLINE void operator delete[](void* p) noexcept { ::operator delete(p); }
+YOYO_NOINLINE void operator delete(void* p, std::size_t) noexcept {
+  ::operator delete(p);
+}
+YOYO_NOINLINE void operator delete[](void* p, std::size_t) noexcept {
+  ::operator delete(p);
+}
+
+std::string loadTestData() {
+  std::ifstream inputFile(YOYO_TEST_DATA);
+  std::stringstream buffer;
+  buffer << inputFile.rdbuf();
+  return buffer.str();
+}
+
+// 测试 arena 稳定后的解析不再调用全局 new
+TEST_CASE("testing arena allocations") {
+  std::string stats = loadTestData();
+  REQUIRE(!stats.empty());
+
+  auto steady_state = [&stats](yoyo::PARSEMODE mode) -> bool {
+    // 预热一次让 arena 的块合并为一个
+    yoyo::JsonArena arena;
+    yoyo::parserJsonArena(stats, arena, mode);
+    arena.reset();
+    for (int i = 0; i < 3; ++i) {
+      size_t before = g_iNewCalls;
+      const yoyo::JsonValue& root = yoyo::parserJsonArena(stats, arena, mode);
+      if (g_iNewCalls != before || !root.isObject()) return false;
+      arena.reset();
+    }
+    return true;
+  };
+
+  CHECK(steady_state(yoyo::PARSEMODE::PARSE_RECURSIVE) == true);
+  CHECK(steady_state(yoyo::PARSEMODE::PARSE_INDEXED) == true);
+  CHECK(steady_state(yoyo::PARSEMODE::PARSE_ITERATIVE) == true);
+}
+
+// 测试校验 (含重复键检查) 不调用全局 new
+TEST_CASE("testing validation allocations") {
+  std::string stats = loadTestData();
+  REQUIRE(!stats.empty());
+
+  size_t before = g_iNewCalls;
+  yoyo::JsonStatus status = yoyo::validateJson(stats, true);
+  yoyo::JsonStatus duplicate = yoyo::validateJson(R"({"a":1,"a":2})");
+  CHECK(g_iNewCalls == before);
+  CHECK(status.ok() == true);
+  CHECK(duplicate.error == yoyo::JSONERROR::ERROR_DUPLICATE_KEY);
+}
+
+// 测试按需解析查找含转义的键不调用全局 new
+TEST_CASE("testing lazy key allocations") {
+  std::string json = R"({"k\u0065y1": 1, "k\"ey": [true, {"\u00e9": 2}]})";
+  yoyo::LazyValue doc(json);
+
+  size_t before = g_iNewCalls;
+  bool found = doc["k\"ey"][1]["\xc3\xa9"].asInt() == 2 &&
+               doc["key1"].asInt() == 1 && !doc.isMember("key");
+  CHECK(g_iNewCalls == before);
+  CHECK(found == true);
+}
@@ -1,4 +1,12 @@
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
 #include <string>
+#include <variant>
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "../src/json_parser.hpp"
 #include "./doctest.h"
@@ -293,4 +301,1527 @@ TEST_CASE("testing add object to array") {
   CHECK(add_object_to_array() == true);
   CHECK(add_object_to_array_with_move() == true);
   CHECK(add_object() == true);
-}
\ No newline at end of file
+}
+// 读取 benchmark 使用的测试数据
+std::string loadTestData() {
+#ifdef YOYO_TEST_DATA
+  std::ifstream inputFile(YOYO_TEST_DATA);
+  std::stringstream buffer;
+  buffer << inputFile.rdbuf();
+  return buffer.str();
+#else
+  return std::string();
+#endif
+}
+
+// 测试两阶段解析与递归解析结果一致
+TEST_CASE("testing structural index parser") {
+  auto same_tree = [](const std::string& json) -> bool {
+    yoyo::JsonValue recursive = yoyo::parserJson(json);
+    yoyo::JsonValue indexed =
+        yoyo::parserJson(json, yoyo::PARSEMODE::PARSE_INDEXED);
+    return recursive.writeToString() == indexed.writeToString();
+  };
+
+  auto escaped_strings = [&same_tree]() -> bool {
+    // 转义引号与反斜杠跨越 64 字节块边界
+    std::string padding(60, ' ');
+    return same_tree(padding + R"({"a\\\"b": "x\\", "c": "\"{[,:]}\""})") &&
+           same_tree(R"([1, -2.5e3, true, false, null, "", [], {}])");
+  };
+
+  auto invalid_input = []() -> bool {
+    const char* cases[] = {"[1,]", "{\"a\" 1}", "[\"abc]", "[1 2]",
+                           "truex", "{} []"};
+    for (const char* json : cases) {
+      try {
+        yoyo::parserJson(json, yoyo::PARSEMODE::PARSE_INDEXED);
+        return false;
+      } catch (const std::exception&) {
+      }
+    }
+    return true;
+  };
+
+  CHECK(same_tree(jsonStr) == true);
+  CHECK(same_tree(loadTestData()) == true);
+  CHECK(escaped_strings() == true);
+  CHECK(invalid_input() == true);
+}
+
+// 测试长字符串的整段拷贝与转义处理
+TEST_CASE("testing string parsing") {
+  auto long_string = []() -> bool {
+    std::string text(100, 'x');
+    yoyo::JsonValue jValue = yoyo::parserJson("\"" + text + "\"");
+    return jValue.asString() == text;
+  };
+
+  auto escapes_between_runs = []() -> bool {
+    std::string run(37, 'a');
+    std::string json = "\"" + run + "\\n" + run + "\\\"" + run + "\\\\\"";
+    yoyo::JsonValue jValue = yoyo::parserJson(json);
+    return jValue.asString() == run + "\n" + run + "\"" + run + "\\";
+  };
+
+  auto control_character = []() -> bool {
+    try {
+      yoyo::parserJson("\"line\nbreak\"");
+    } catch (const std::exception&) {
+      return true;
+    }
+    return false;
+  };
+
+  auto all_escapes = []() -> bool {
+    yoyo::JsonValue jValue = yoyo::parserJson(
+        R"(["\/\b\f\n\r\t", "\u0041\u00e9\u4E2D", "\ud83d\ude00"])");
+    return jValue[0].asString() == "/\b\f\n\r\t" &&
+           jValue[1].asString() == "A\xC3\xA9\xE4\xB8\xAD" &&
+           jValue[2].asString() == "\xF0\x9F\x98\x80";
+  };
+
+  auto invalid_escapes = []() -> bool {
+    for (const char* json : {R"("\q")", R"("\u12g4")", R"("\u12")",
+                             R"("\ud800")", R"("\udc00")",
+                             R"("\ud800\u0041")"}) {
+      try {
+        yoyo::parserJson(json);
+        return false;
+      } catch (const std::exception&) {
+      }
+    }
+    return true;
+  };
+
+  CHECK(long_string() == true);
+  CHECK(escapes_between_runs() == true);
+  CHECK(control_character() == true);
+  CHECK(all_escapes() == true);
+  CHECK(invalid_escapes() == true);
+}
+
+// 递归比较 tape 文档与 JsonFiled 树
+bool sameValue(const yoyo::DocumentValue& doc, const yoyo::JsonFiled& json) {
+  if (doc.getType() != json.getType()) return false;
+  switch (json.getType()) {
+    case yoyo::JSONTYPE::JSON_NULL:
+      return true;
+    case yoyo::JSONTYPE::JSON_BOOLEAN:
+      return doc.asBool() == json.asBool();
+    case yoyo::JSONTYPE::JSON_NUMBER:
+      return doc.asInt() == json.asInt();
+    case yoyo::JSONTYPE::JSON_DOUBLE:
+      return doc.asDouble() == json.asDouble();
+    case yoyo::JSONTYPE::JSON_STRING:
+      return doc.asString() == json.asString();
+    case yoyo::JSONTYPE::JSON_ARRAY: {
+      if (doc.size() != json.size()) return false;
+      size_t i = 0;
+      for (auto it = doc.begin(); it != doc.end(); ++it, ++i) {
+        if (!sameValue(*it, json.get<yoyo::JsonFiled::json_array>()[i]))
+          return false;
+      }
+      return true;
+    }
+    case yoyo::JSONTYPE::JSON_OBJECT: {
+      if (doc.size() != json.size()) return false;
+      auto obj = json.get<yoyo::JsonFiled::json_object>();
+      for (auto it = doc.begin(); it != doc.end(); ++it) {
+        auto found = obj.find(std::string(it.key()));
+        if (found == obj.end() || !sameValue(*it, found->second)) return false;
+      }
+      return true;
+    }
+  }
+  return false;
+}
+
+// 测试 tape 文档
+TEST_CASE("testing tape document") {
+  yoyo::Document doc;
+
+  auto same_as_tree = [&doc](const std::string& json) -> bool {
+    doc.parse(json);
+    return sameValue(doc.root(), yoyo::parserJson(json));
+  };
+
+  auto navigation = [&doc]() -> bool {
+    doc.parse(loadTestData());
+    yoyo::DocumentValue broker = doc.root()["brokers"]["127.0.0.1:9092/1"];
+    return broker["name"].asString() == "127.0.0.1:9092/1" &&
+           broker["nodeid"].asInt() == 1 && broker.isMember("rtt") &&
+           !broker.isMember("nothing") && doc.root()["ts"].asInt() > 0;
+  };
+
+  auto large_numbers = [&doc]() -> bool {
+    doc.parse(R"([9007199254740993, -1, 1.5, 1e300, [], {}])");
+    yoyo::DocumentValue root = doc.root();
+    return root.size() == 6 && root[0].asInt() == 9007199254740993LL &&
+           root[1].asInt() == -1 && root[2].asDouble() == 1.5 &&
+           root[3].asDouble() == 1e300 && root[4].isEmpty() &&
+           root[5].isObject();
+  };
+
+  // 与树解析器接受同样的输入, 错误码和位置也一致
+  auto rejects_like_tree = [&doc, &same_as_tree]() -> bool {
+    std::string bigObject = "{";
+    for (int i = 0; i < 40; i++) {
+      bigObject += "\"k" + std::to_string(i) + "\": 1, ";
+    }
+    bigObject += "\"k17\": 0}";
+    const std::string cases[] = {
+        "[1e400]", "[-3.1e4159]", R"({"a": 1, "a": 2})",
+        R"({"x": {"a": 1, "b": 2, "a": 3}})", R"({"\u0061": 1, "a": 2})",
+        bigObject};
+    for (const std::string& json : cases) {
+      yoyo::JsonResult tree = yoyo::tryParseJson(json);
+      try {
+        doc.parse(json);
+        return false;
+      } catch (const yoyo::JsonParseError& e) {
+        if (e.getErrorCode() != tree.error ||
+            e.getErrorIndex() != tree.offset) {
+          return false;
+        }
+      }
+    }
+    // 不同对象中的同名键互不影响
+    return same_as_tree(R"({"a": {"a": 1}, "b": [{"a": 2}, {"a": 3}]})");
+  };
+
+  auto leading_zeros = [&doc, &same_as_tree]() -> bool {
+    // 文档与树共用数字扫描, 都拒绝前导零
+    for (const char* json : {"01", "-01", "[01]", "[1, 00.5]"}) {
+      try {
+        doc.parse(json);
+        return false;
+      } catch (const std::exception&) {
+      }
+      try {
+        yoyo::parserJson(json);
+        return false;
+      } catch (const std::exception&) {
+      }
+    }
+    return same_as_tree("[0, -0, 0.5, 10, -0e1]");
+  };
+
+  CHECK(same_as_tree(jsonStr) == true);
+  CHECK(same_as_tree(loadTestData()) == true);
+  CHECK(navigation() == true);
+  CHECK(large_numbers() == true);
+  CHECK(rejects_like_tree() == true);
+  CHECK(leading_zeros() == true);
+}
+
+// 测试按需解析
+TEST_CASE("testing lazy navigation") {
+  std::string stats = loadTestData();
+  yoyo::LazyValue doc(stats);
+  yoyo::JsonValue tree = yoyo::parserJson(stats);
+
+  auto path_lookup = [&]() -> bool {
+    yoyo::LazyValue rtt = doc["brokers"]["127.0.0.1:9092/1"]["rtt"];
+    return rtt["avg"].asInt() ==
+               tree["brokers"]["127.0.0.1:9092/1"]["rtt"]["avg"].asInt() &&
+           doc["name"].asString() == tree["name"].asString() &&
+           doc["brokers"].size() == tree["brokers"].size();
+  };
+
+  auto array_and_escapes = []() -> bool {
+    std::string json =
+        R"({"skip": [1, {"x": "]}\""}], "k\"ey": [true, null, -2.5, "v"]})";
+    yoyo::LazyValue value(json);
+    yoyo::LazyValue list = value["k\"ey"];
+    return list.size() == 4 && list[0].asBool() && list[1].isNull() &&
+           list[2].asDouble() == -2.5 && list[3].asString() == "v" &&
+           value["skip"].getRaw() == R"([1, {"x": "]}\""}])" &&
+           !value.isMember("missing");
+  };
+
+  auto escaped_keys = []() -> bool {
+    // 含转义的键边解码边比较: 前缀相同, 长度不同与非法转义
+    std::string json = R"({"\u00e9t\u00e9": 1, "a\tb": 2, "a\t": 3})";
+    yoyo::LazyValue value(json);
+    if (value["\xc3\xa9t\xc3\xa9"].asInt() != 1 || value["a\tb"].asInt() != 2 ||
+        value["a\t"].asInt() != 3 || value.isMember("a\tbc") ||
+        value.isMember("a") || value.isMember("\xc3\xa9t")) {
+      return false;
+    }
+    std::string bad = R"({"a\x": 1})";
+    try {
+      yoyo::LazyValue broken(bad);
+      broken.isMember("a");
+      return false;
+    } catch (const std::exception&) {
+    }
+    return true;
+  };
+
+  CHECK(path_lookup() == true);
+  CHECK(array_and_escapes() == true);
+  CHECK(escaped_keys() == true);
+}
+
+// 测试零拷贝输入
+TEST_CASE("testing zero-copy input") {
+  auto borrowed_buffer = []() -> bool {
+    const char buffer[] = R"({"name": "yoyo", "list": [1, 2]}trailing)";
+    yoyo::JsonValue jValue = yoyo::parserJson(buffer, 32);
+    return jValue["name"].asString() == "yoyo" && jValue["list"].size() == 2;
+  };
+
+  auto padded_buffer = []() -> bool {
+    // 有效数据之后跟着不属于文档的填充字节
+    std::string json = R"(["abc",   "def"])";
+    std::string buffer = json + std::string(yoyo::JSON_PADDING, '"');
+    yoyo::JsonParser parser(buffer.data(), json.size(), buffer.size());
+    yoyo::JsonValue jValue = parser.parser();
+    return jValue.size() == 2 && jValue[1].asString() == "def";
+  };
+
+  auto owned_rvalue = []() -> bool {
+    yoyo::JsonParser parser(std::string(R"({"k": "v"})"));
+    yoyo::JsonParser moved(std::move(parser));
+    return moved.parser()["k"].asString() == "v";
+  };
+
+  CHECK(borrowed_buffer() == true);
+  CHECK(padded_buffer() == true);
+  CHECK(owned_rvalue() == true);
+}
+
+// 测试借用与原位解析模式
+TEST_CASE("testing borrowed strings") {
+  auto in_buffer = [](std::string_view buffer, std::string_view str) -> bool {
+    return str.data() >= buffer.data() &&
+           str.data() + str.size() <= buffer.data() + buffer.size();
+  };
+
+  auto borrowed = [&in_buffer]() -> bool {
+    std::string json = R"({"name": "plain", "escaped": "a\"b"})";
+    yoyo::JsonValue jValue = yoyo::parserJsonBorrowed(json);
+    const auto& obj = jValue.get<yoyo::JsonFiled::json_object>();
+    for (const auto& [key, value] : obj) {
+      if (!key.isBorrowed() || !in_buffer(json, key.view())) return false;
+    }
+    return jValue["name"].isBorrowed() && !jValue["escaped"].isBorrowed() &&
+           jValue["name"].asString() == "plain" &&
+           jValue["escaped"].asString() == "a\"b";
+  };
+
+  auto in_situ = []() -> bool {
+    std::string json = R"(["tab\tand\\slash", {"k\"ey": "v"}])";
+    yoyo::JsonValue jValue = yoyo::parserJsonInSitu(
+        json.data(), json.size(), yoyo::PARSEMODE::PARSE_INDEXED);
+    return jValue[0].isBorrowed() &&
+           jValue[0].asString() == "tab\tand\\slash" &&
+           jValue[1].isMember("k\"ey") &&
+           jValue.writeToString() == R"(["tab\tand\\slash",{"k\"ey":"v"}])";
+  };
+
+  CHECK(borrowed() == true);
+  CHECK(in_situ() == true);
+}
+
+// 测试 arena 解析
+TEST_CASE("testing arena parsing") {
+  yoyo::JsonArena arena(4096);
+  std::string stats = loadTestData();
+
+  auto same_as_heap = [&arena, &stats]() -> bool {
+    const yoyo::JsonValue& root = yoyo::parserJsonArena(stats, arena);
+    bool same = root.writeToString() == yoyo::parserJson(stats).writeToString();
+    bool borrowed = root["name"].isBorrowed();
+    arena.reset();
+    return same && borrowed && arena.bytesUsed() == 0;
+  };
+
+  auto reuse_blocks = [&arena, &stats]() -> bool {
+    yoyo::parserJsonArena(stats, arena, yoyo::PARSEMODE::PARSE_INDEXED);
+    arena.reset();  // 多个块合并为一个
+    size_t reserved = arena.bytesReserved();
+    for (int i = 0; i < 3; ++i) {
+      const yoyo::JsonValue& root =
+          yoyo::parserJsonArena(stats, arena, yoyo::PARSEMODE::PARSE_INDEXED);
+      if (root["brokers"].size() != 3) return false;
+      arena.reset();
+    }
+    return arena.blockCount() == 1 && arena.bytesReserved() == reserved;
+  };
+
+  auto escaped_strings = [&arena]() -> bool {
+    const yoyo::JsonValue& root =
+        yoyo::parserJsonArena(R"({"a\"b": ["x\\y", "plain"]})", arena);
+    return root.isMember("a\"b") && root["a\"b"][0].asString() == "x\\y" &&
+           root["a\"b"][1].asString() == "plain";
+  };
+
+  auto read_only_strings = [&arena]() -> bool {
+    // arena 树不逐个析构, 修改其中的字符串时抛异常而不是泄漏堆上的拷贝
+    std::string json = R"({"s": "a long string value", "n": 12.5})";
+    for (bool lazy : {false, true}) {
+      for (auto mode : {yoyo::PARSEMODE::PARSE_RECURSIVE,
+                        yoyo::PARSEMODE::PARSE_INDEXED,
+                        yoyo::PARSEMODE::PARSE_ITERATIVE}) {
+        yoyo::JsonParser parser(json);
+        parser.setArena(&arena);
+        parser.setLazyScalars(lazy);
+        yoyo::JsonValue& root =
+            *arena.create<yoyo::JsonValue>(parser.parse(mode));
+        try {
+          root["s"].getRef<std::string>() += "!";
+          return false;
+        } catch (const std::logic_error&) {
+        }
+        root["n"].getRef<yoyo::JsonValue::json_double>() *= 2;  // 不需要分配
+        yoyo::JsonValue copy = root;  // 拷贝回到全局分配, 可以修改
+        copy["s"].getRef<std::string>() += "!";
+        if (root["s"].asString() != "a long string value" ||
+            copy["s"].asString() != "a long string value!" ||
+            root["n"].asDouble() != 25)
+          return false;
+      }
+    }
+    arena.reset();
+    return true;
+  };
+
+  CHECK(same_as_heap() == true);
+  CHECK(reuse_blocks() == true);
+  CHECK(escaped_strings() == true);
+  CHECK(read_only_strings() == true);
+}
+
+// 测试扁平对象容器
+TEST_CASE("testing flat object") {
+  auto insertion_order = []() -> bool {
+    yoyo::JsonValue root = yoyo::parserJson(R"({"z": 1, "a": 2, "m": 3})");
+    return root.writeToString() == R"({"z":1,"a":2,"m":3})";
+  };
+
+  auto indexed_lookup = []() -> bool {
+    // 成员数超过阈值后走哈希索引
+    yoyo::JsonValue root;
+    for (int i = 0; i < 100; ++i) root["key" + std::to_string(i)] = i;
+    if (root.size() != 100) return false;
+    if (!root.isMember(std::string("key99"))) return false;
+    for (int i = 0; i < 100; ++i) {
+      if (root["key" + std::to_string(i)].asInt() != i) return false;
+    }
+    yoyo::JsonValue::json_object obj = root.asObject();
+    return obj.erase("key0") == 1 && obj.size() == 99 &&
+           !obj.contains("key0") && obj.find("key50")->second.asInt() == 50 &&
+           obj.begin()->first.view() == "key1";
+  };
+
+  auto repeated_erase = []() -> bool {
+    // 哈希索引逐个删除后仍与剩余成员一致
+    yoyo::JsonFiled::json_object obj;
+    for (int i = 0; i < 1000; ++i) obj["key" + std::to_string(i)] = i;
+    for (int i = 0; i < 1000; i += 3) obj.erase("key" + std::to_string(i));
+    for (int i = 0; i < 1000; ++i) {
+      auto it = obj.find("key" + std::to_string(i));
+      if ((i % 3 == 0) != (it == obj.end())) return false;
+      if (it != obj.end() && it->second.asInt() != i) return false;
+    }
+    for (int i = 1; i < 990; ++i) obj.erase("key" + std::to_string(i));
+    int expected = 991;
+    for (const auto& [key, value] : obj) {
+      if (expected % 3 == 0) expected++;
+      if (key.view() != "key" + std::to_string(expected) ||
+          value.asInt() != expected || &obj.find(key.view())->second != &value)
+        return false;
+      expected++;
+    }
+    return obj.size() == 6 && expected == 999 && !obj.contains("key1");
+  };
+
+  auto duplicate_key = []() -> bool {
+    std::string json = R"({"a": 1, "b": 2, "a": 3})";
+    try {
+      yoyo::parserJson(json);
+      return false;
+    } catch (const yoyo::JsonParseError&) {
+    }
+    try {
+      yoyo::parserJson(json, yoyo::PARSEMODE::PARSE_INDEXED);
+      return false;
+    } catch (const yoyo::JsonParseError&) {
+    }
+    return true;
+  };
+
+  CHECK(insertion_order() == true);
+  CHECK(indexed_lookup() == true);
+  CHECK(repeated_erase() == true);
+  CHECK(duplicate_key() == true);
+}
+
+// 测试键驻留
+TEST_CASE("testing key interning") {
+  yoyo::JsonKeyDict dict;
+  std::string stats = loadTestData();
+
+  auto same_as_copy = [&dict, &stats]() -> bool {
+    yoyo::JsonValue root = yoyo::parserJsonInterned(stats, dict);
+    yoyo::JsonValue indexed = yoyo::parserJsonInterned(
+        stats, dict, yoyo::PARSEMODE::PARSE_INDEXED);
+    std::string expected = yoyo::parserJson(stats).writeToString();
+    return root.writeToString() == expected &&
+           indexed.writeToString() == expected;
+  };
+
+  auto shared_across_documents = [&dict]() -> bool {
+    yoyo::JsonValue first = yoyo::parserJsonInterned(R"({"name": 1})", dict);
+    size_t keys = dict.size();
+    yoyo::JsonValue second =
+        yoyo::parserJsonInterned(R"({"name": 2, "extra": 3})", dict);
+    yoyo::JsonValue::json_object objA = first.asObject();
+    yoyo::JsonValue::json_object objB = second.asObject();
+    const auto& a = *objA.begin();
+    const auto& b = *objB.begin();
+    return a.first.isInterned() && a.first == b.first &&
+           a.first.view().data() == b.first.view().data() &&
+           dict.size() == keys + 1 && second["name"].asInt() == 2;
+  };
+
+  CHECK(same_as_copy() == true);
+  CHECK(shared_across_documents() == true);
+}
+
+// 测试迭代解析与运行时深度限制
+TEST_CASE("testing iterative parser") {
+  auto same_as_recursive = []() -> bool {
+    std::string stats = loadTestData();
+    std::string expected = yoyo::parserJson(stats).writeToString();
+    yoyo::JsonValue root =
+        yoyo::parserJson(stats, yoyo::PARSEMODE::PARSE_ITERATIVE);
+    yoyo::JsonValue empty = yoyo::parserJson(
+        R"( {"a": [], "b": {}, "c": [{}]} )", yoyo::PARSEMODE::PARSE_ITERATIVE);
+    return root.writeToString() == expected &&
+           empty.writeToString() == R"({"a":[],"b":{},"c":[{}]})";
+  };
+
+  auto depth_limit = []() -> bool {
+    // 每种模式下最大深度都按容器嵌套层数计算
+    for (auto mode : {yoyo::PARSEMODE::PARSE_RECURSIVE,
+                      yoyo::PARSEMODE::PARSE_INDEXED,
+                      yoyo::PARSEMODE::PARSE_ITERATIVE}) {
+      yoyo::JsonParser ok(R"([{"a": []}])");
+      ok.setMaxDepth(3);
+      ok.parse(mode);
+      yoyo::JsonParser deep(R"([{"a": [[]]}])");
+      deep.setMaxDepth(3);
+      try {
+        deep.parse(mode);
+        return false;
+      } catch (const yoyo::JsonParseError&) {
+      }
+    }
+    return true;
+  };
+
+  auto very_deep = []() -> bool {
+    const size_t depth = 20000;
+    std::string json = std::string(depth, '[') + std::string(depth, ']');
+    yoyo::JsonParser parser(json);
+    parser.setMaxDepth(depth);
+    yoyo::JsonValue root = parser.parse(yoyo::PARSEMODE::PARSE_ITERATIVE);
+    return root.isArray();
+  };
+
+  auto deep_tree_operations = []() -> bool {
+    // 拷贝, 统计内存和输出都不随嵌套深度递归
+    const size_t depth = 20000;
+    std::string json;
+    for (size_t i = 0; i < depth; ++i) json += i % 2 ? "{\"k\":" : "[1,";
+    json += "null";
+    for (size_t i = depth; i-- > 0;) json += i % 2 ? "}" : "]";
+    yoyo::JsonParser parser(json);
+    parser.setMaxDepth(depth);
+    yoyo::JsonValue root = parser.parse(yoyo::PARSEMODE::PARSE_ITERATIVE);
+    yoyo::JsonValue copy = root;
+    yoyo::JsonWriteOptions options;
+    options.pretty = true;
+    options.indentWidth = 0;
+    std::string pretty = copy.writeToString(options);
+    return copy.writeToString() == json &&
+           copy.memoryUsage() > depth * sizeof(yoyo::JsonValue) &&
+           root.memoryUsage() >= copy.memoryUsage() &&
+           pretty.size() > json.size();
+  };
+
+  auto recursive_cap = []() -> bool {
+    // 递归的两种模式不论 setMaxDepth 多大都不超过 MAX_RECURSIVE_DEPTH
+    const size_t limit = yoyo::JsonParser::MAX_RECURSIVE_DEPTH;
+    for (auto mode :
+         {yoyo::PARSEMODE::PARSE_RECURSIVE, yoyo::PARSEMODE::PARSE_INDEXED}) {
+      std::string ok = std::string(limit, '[') + std::string(limit, ']');
+      std::string deep = "[" + ok + "]";
+      yoyo::JsonParser okParser(ok);
+      yoyo::JsonParser deepParser(deep);
+      okParser.setMaxDepth(limit * 100);
+      deepParser.setMaxDepth(limit * 100);
+      yoyo::JsonResult result = deepParser.tryParse(mode);
+      if (!okParser.tryParse(mode) ||
+          result.error != yoyo::JSONERROR::ERROR_DEPTH_EXCEEDED ||
+          result.offset != limit)
+        return false;
+    }
+    return true;
+  };
+
+  auto malformed = []() -> bool {
+    for (const char* json : {"[1, 2", "[1 2]", R"({"a" 1})", R"({"a": 1,})",
+                             R"({"a": 1, "a": 2})", "[1] x"}) {
+      try {
+        yoyo::parserJson(json, yoyo::PARSEMODE::PARSE_ITERATIVE);
+        return false;
+      } catch (const std::exception&) {
+      }
+    }
+    return true;
+  };
+
+  CHECK(same_as_recursive() == true);
+  CHECK(depth_limit() == true);
+  CHECK(very_deep() == true);
+  CHECK(deep_tree_operations() == true);
+  CHECK(recursive_cap() == true);
+  CHECK(malformed() == true);
+}
+
+// 测试不抛异常的解析接口
+TEST_CASE("testing error codes") {
+  auto error_of = [](const char* json, yoyo::PARSEMODE mode) {
+    return yoyo::tryParseJson(json, mode).error;
+  };
+
+  auto same_in_all_modes = [&error_of]() -> bool {
+    struct Case {
+      const char* json;
+      yoyo::JSONERROR error;
+    };
+    const Case cases[] = {
+        {"", yoyo::JSONERROR::ERROR_EMPTY_INPUT},
+        {"[1, 2", yoyo::JSONERROR::ERROR_UNEXPECTED_END},
+        {R"({"a": "abc)", yoyo::JSONERROR::ERROR_UNEXPECTED_END},
+        {"[nul]", yoyo::JSONERROR::ERROR_INVALID_LITERAL},
+        {"[-]", yoyo::JSONERROR::ERROR_INVALID_NUMBER},
+        {"[1e999]", yoyo::JSONERROR::ERROR_NUMBER_OUT_OF_RANGE},
+        {R"(["a\q"])", yoyo::JSONERROR::ERROR_INVALID_STRING},
+        {"{1: 2}", yoyo::JSONERROR::ERROR_EXPECTED_KEY},
+        {R"({"a" 1})", yoyo::JSONERROR::ERROR_EXPECTED_COLON},
+        {R"({"a": 1 "b": 2})", yoyo::JSONERROR::ERROR_EXPECTED_SEPARATOR},
+        {R"({"a": 1, "a": 2})", yoyo::JSONERROR::ERROR_DUPLICATE_KEY},
+        {"[1] 2", yoyo::JSONERROR::ERROR_TRAILING_CONTENT},
+        {"[1, ]", yoyo::JSONERROR::ERROR_INVALID_VALUE},
+        {"[01]", yoyo::JSONERROR::ERROR_INVALID_NUMBER},
+        {"-01", yoyo::JSONERROR::ERROR_INVALID_NUMBER},
+        {"[0.5, -00.5]", yoyo::JSONERROR::ERROR_INVALID_NUMBER},
+        {R"(["\u12g4"])", yoyo::JSONERROR::ERROR_INVALID_STRING},
+        {R"(["\ud800"])", yoyo::JSONERROR::ERROR_INVALID_STRING},
+        {R"(["\udc00"])", yoyo::JSONERROR::ERROR_INVALID_STRING},
+        {R"(["\ud800\u0041"])", yoyo::JSONERROR::ERROR_INVALID_STRING},
+    };
+    for (const Case& c : cases) {
+      for (auto mode : {yoyo::PARSEMODE::PARSE_RECURSIVE,
+                        yoyo::PARSEMODE::PARSE_INDEXED,
+                        yoyo::PARSEMODE::PARSE_ITERATIVE}) {
+        if (error_of(c.json, mode) != c.error) return false;
+      }
+    }
+    return true;
+  };
+
+  auto offset_and_value = []() -> bool {
+    yoyo::JsonResult bad = yoyo::tryParseJson(R"({"a": 1, "b": tru})");
+    yoyo::JsonResult good = yoyo::tryParseJson(R"({"a": [1, 2]})");
+    return !bad && bad.offset == 14 && bad.value.isNull() && good.ok() &&
+           good.value["a"][1].asInt() == 2;
+  };
+
+  auto throwing_wrapper = []() -> bool {
+    try {
+      yoyo::parserJson("[1, 2");
+    } catch (const std::logic_error& e) {  // JsonParseError 也是 logic_error
+      auto* error = dynamic_cast<const yoyo::JsonParseError*>(&e);
+      return error != nullptr &&
+             error->getErrorCode() == yoyo::JSONERROR::ERROR_UNEXPECTED_END &&
+             error->getErrorIndex() == 5;
+    }
+    return false;
+  };
+
+  auto escapes = []() -> bool {
+    std::string json =
+        R"(["\u00e9", "\/", "\b\f", "\ud83d\ude00", "\u4E2D", 0, -0.5])";
+    const char* expected[] = {"\xC3\xA9", "/", "\b\f", "\xF0\x9F\x98\x80",
+                              "\xE4\xB8\xAD"};
+    auto same = [&expected](const yoyo::JsonValue& root) {
+      for (int i = 0; i < 5; i++) {
+        if (root[i].asString() != expected[i]) return false;
+      }
+      return root[5].asInt() == 0 && root[6].asDouble() == -0.5;
+    };
+    for (auto mode : {yoyo::PARSEMODE::PARSE_RECURSIVE,
+                      yoyo::PARSEMODE::PARSE_INDEXED,
+                      yoyo::PARSEMODE::PARSE_ITERATIVE}) {
+      if (!same(yoyo::parserJson(json, mode))) return false;
+    }
+    std::string buffer = json;
+    return same(yoyo::parserJsonInSitu(buffer.data(), buffer.size())) &&
+           same(yoyo::parserJsonLazy(json));
+  };
+
+  CHECK(same_in_all_modes() == true);
+  CHECK(offset_and_value() == true);
+  CHECK(throwing_wrapper() == true);
+  CHECK(escapes() == true);
+}
+
+// 测试 64 位整数
+TEST_CASE("testing 64-bit integers") {
+  auto full_range = []() -> bool {
+    std::string json =
+        "[1700000000123456, 9223372036854775807, -9223372036854775808, "
+        "18446744073709551615, 18446744073709551616]";
+    for (auto mode : {yoyo::PARSEMODE::PARSE_RECURSIVE,
+                      yoyo::PARSEMODE::PARSE_INDEXED,
+                      yoyo::PARSEMODE::PARSE_ITERATIVE}) {
+      yoyo::JsonValue root = yoyo::parserJson(json, mode);
+      if (root[0].asInt() != 1700000000123456 ||
+          root[1].asInt() != INT64_MAX || root[2].asInt() != INT64_MIN ||
+          root[3].asUInt() != UINT64_MAX || !root[4].isDouble())
+        return false;
+    }
+    yoyo::Document document;
+    document.parse(json);
+    return document.root()[2].asInt() == INT64_MIN &&
+           document.root()[3].asUInt() == UINT64_MAX &&
+           document.root()[4].isDouble();
+  };
+
+  auto digit_lengths = []() -> bool {
+    // 覆盖 SWAR 分组的各种长度 (1~20 位)
+    uint64_t expected = 0;
+    std::string digits;
+    for (int i = 1; i <= 20; ++i) {
+      digits += static_cast<char>('0' + i % 10);
+      expected = expected * 10 + static_cast<uint64_t>(i % 10);
+      yoyo::JsonValue value = yoyo::parserJson("[" + digits + "]")[0];
+      if (value.asUInt() != expected || value != expected) return false;
+    }
+    return true;
+  };
+
+  auto conversions = []() -> bool {
+    yoyo::JsonValue big = uint64_t{1} << 63;
+    yoyo::JsonValue small = size_t{42};
+    bool threw = false;
+    try {
+      big.get<int>();
+    } catch (const std::logic_error&) {
+      threw = true;
+    }
+    return threw && big.writeToString() == "9223372036854775808" &&
+           small.asInt() == 42 && small.get<int>() == 42;
+  };
+
+  CHECK(full_range() == true);
+  CHECK(digit_lengths() == true);
+  CHECK(conversions() == true);
+}
+
+TEST_CASE("testing double parsing") {
+  // 与 strtod 逐位比较
+  auto sameBits = [](double a, double b) {
+    return std::memcmp(&a, &b, sizeof(a)) == 0;
+  };
+
+  auto edge_cases = [&]() -> bool {
+    const char* cases[] = {"0.0",
+                           "-0.0",
+                           "0.1",
+                           "1000000.00",
+                           "3.141592653589793",
+                           "-122.419416",
+                           "1e22",
+                           "1e23",
+                           "12345e30",
+                           "9007199254740993.0",
+                           "2.2250738585072014e-308",
+                           "4.9406564584124654e-324",
+                           "1.7976931348623157e308",
+                           "0.30000000000000004",
+                           "123456789012345678901234567890.5",
+                           "7.0e-10",
+                           "1E+2"};
+    for (const char* text : cases) {
+      double expected = std::strtod(text, nullptr);
+      std::string json = std::string("[") + text + "]";
+      for (auto mode : {yoyo::PARSEMODE::PARSE_RECURSIVE,
+                        yoyo::PARSEMODE::PARSE_INDEXED,
+                        yoyo::PARSEMODE::PARSE_ITERATIVE}) {
+        if (!sameBits(yoyo::parserJson(json, mode)[0].asDouble(), expected))
+          return false;
+      }
+      yoyo::Document document;
+      document.parse(json);
+      if (!sameBits(document.root()[0].asDouble(), expected)) return false;
+    }
+    return true;
+  };
+
+  auto random_values = [&]() -> bool {
+    // 随机位模式的 double 按最短精度与 %.6f 打印后再解析
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+    char buffer[64];
+    for (int i = 0; i < 20000; ++i) {
+      state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+      uint64_t bits = state;
+      double value;
+      std::memcpy(&value, &bits, sizeof(value));
+      if (value != value || value - value != 0) continue;  // 跳过 NaN/Inf
+      const char* format = i % 2 ? "%.17g" : "%.6f";
+      if (i % 2 == 0) value = static_cast<double>(bits % 100000000) / 7;
+      std::snprintf(buffer, sizeof(buffer), format, value);
+      size_t pos = 0;
+      double parsed = 0;
+      if (yoyo::detail::tryParseDouble(buffer, std::strlen(buffer), pos,
+                                       parsed) != yoyo::JSONERROR::ERROR_NONE ||
+          !sameBits(parsed, std::strtod(buffer, nullptr)))
+        return false;
+    }
+    return true;
+  };
+
+  auto out_of_range = [&]() -> bool {
+    yoyo::JsonResult result = yoyo::tryParseJson("[1e999]");
+    // 按需解析与 strtod 一致, 上溢为 inf, 下溢为 0
+    const std::string json = "[1e400, -0.00001e-400, -12e3000]";
+    yoyo::LazyValue root(json);
+    return !result && result.offset == 1 &&
+           result.error == yoyo::JSONERROR::ERROR_NUMBER_OUT_OF_RANGE &&
+           root[0].asDouble() == std::numeric_limits<double>::infinity() &&
+           sameBits(root[1].asDouble(), -0.0) &&
+           root[2].asDouble() == -std::numeric_limits<double>::infinity();
+  };
+
+  CHECK(edge_cases() == true);
+  CHECK(random_values() == true);
+  CHECK(out_of_range() == true);
+}
+
+// 测试延迟解码
+TEST_CASE("testing lazy scalars") {
+  auto decode_on_read = []() -> bool {
+    std::string json =
+        R"({"a": 12, "b": -3.25e2, "c": "x\ty", "d": "plain", "e": [1.5]})";
+    yoyo::JsonValue root = yoyo::parserJsonLazy(json);
+    return root["a"].isRaw() && root["a"].isInt() && root["a"] == 12 &&
+           root["a"].asUInt() == 12 && root["b"].isDouble() &&
+           root["b"].asDouble() == -325.0 && root["c"].asString() == "x\ty" &&
+           root["d"] == std::string("plain") &&
+           root["e"][0].asDouble() == 1.5;
+  };
+
+  auto verbatim_output = []() -> bool {
+    // 未读取的标量原样输出, 包括转义与数字写法
+    std::string json = R"({"n":-0.50E+1,"s":"a\"b\\n","i":[7,"\t"]})";
+    yoyo::JsonValue root = yoyo::parserJsonLazy(json);
+    return root.writeToString() == json;
+  };
+
+  auto same_as_eager = []() -> bool {
+    // 原样输出再按默认方式解析, 结果与直接解析一致
+    std::string stats = loadTestData();
+    std::string eager = yoyo::parserJson(stats).writeToString();
+    for (auto mode : {yoyo::PARSEMODE::PARSE_RECURSIVE,
+                      yoyo::PARSEMODE::PARSE_INDEXED,
+                      yoyo::PARSEMODE::PARSE_ITERATIVE}) {
+      yoyo::JsonValue lazy = yoyo::parserJsonLazy(stats, mode);
+      if (yoyo::parserJson(lazy.writeToString()).writeToString() != eager)
+        return false;
+    }
+    return true;
+  };
+
+  auto errors_at_parse = []() -> bool {
+    // 错误仍在解析时报告, 可能超出范围的数立即转换
+    auto tryLazy = [](std::string_view json) {
+      yoyo::JsonParser parser(json);
+      parser.setLazyScalars(true);
+      return parser.tryParse();
+    };
+    yoyo::JsonResult range = tryLazy("[1e999]");
+    yoyo::JsonResult escape = tryLazy(R"(["ab\x"])");
+    yoyo::JsonResult big = tryLazy("[123456789012345678901234]");
+    return range.error == yoyo::JSONERROR::ERROR_NUMBER_OUT_OF_RANGE &&
+           escape.error == yoyo::JSONERROR::ERROR_INVALID_STRING &&
+           escape.offset == 5 && big && big.value[0].isDouble() &&
+           !big.value[0].isRaw();
+  };
+
+  CHECK(decode_on_read() == true);
+  CHECK(verbatim_output() == true);
+  CHECK(same_as_eager() == true);
+  CHECK(errors_at_parse() == true);
+}
+
+// 测试数字输出
+TEST_CASE("testing number formatting") {
+  auto integers = []() -> bool {
+    // 覆盖每个位数的边界
+    uint64_t power = 1;
+    for (int digits = 1; digits <= 20; ++digits) {
+      for (uint64_t value : {power, power - 1, power * 9}) {
+        if (value <= INT64_MAX && yoyo::JsonValue(value).writeToString() !=
+                                      std::to_string(value))
+          return false;
+      }
+      if (digits < 20) power *= 10;
+    }
+    return yoyo::JsonValue(INT64_MIN).writeToString() ==
+               "-9223372036854775808" &&
+           yoyo::JsonValue(UINT64_MAX).writeToString() ==
+               "18446744073709551615" &&
+           yoyo::JsonValue(0).writeToString() == "0";
+  };
+
+  auto shortest_doubles = []() -> bool {
+    return yoyo::JsonValue(0.1).writeToString() == "0.1" &&
+           yoyo::JsonValue(1.0).writeToString() == "1.0" &&
+           yoyo::JsonValue(-2.5e-8).writeToString() == "-2.5e-08" &&
+           yoyo::JsonValue(1e22).writeToString() == "1e+22" &&
+           yoyo::JsonValue(std::nan("")).writeToString() == "null";
+  };
+
+  auto round_trip = []() -> bool {
+    // 随机位模式的 double 写出后再解析, 得到同一个值且仍是浮点数
+    uint64_t state = 0x853C49E6748FEA9BULL;
+    for (int i = 0; i < 20000; ++i) {
+      state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+      double value;
+      std::memcpy(&value, &state, sizeof(value));
+      if (value != value || value - value != 0) continue;  // 跳过 NaN/Inf
+      std::string text = yoyo::JsonValue(value).writeToString();
+      yoyo::JsonValue parsed = yoyo::parserJson("[" + text + "]")[0];
+      if (!parsed.isDouble() || parsed.asDouble() != value) return false;
+    }
+    return true;
+  };
+
+  CHECK(integers() == true);
+  CHECK(shortest_doubles() == true);
+  CHECK(round_trip() == true);
+}
+
+// 测试输出目标
+TEST_CASE("testing serializer sinks") {
+  yoyo::JsonValue root = yoyo::parserJson(loadTestData());
+  std::string expected = root.writeToString();
+
+  auto string_sink = [&]() -> bool {
+    std::string out = "prefix:";  // 追加, 不覆盖已有内容
+    yoyo::StringSink sink(out);
+    yoyo::writeJson(root, sink);
+    std::ostringstream os;
+    os << root;
+    return out == "prefix:" + expected && os.str() == expected;
+  };
+
+  auto buffer_sink = []() -> bool {
+    yoyo::JsonValue value = yoyo::parserJson(R"({"a":[1,2.5,"x\ny"]})");
+    char exact[20];
+    yoyo::BufferSink fits(exact);
+    yoyo::writeJson(value, fits);
+    char small[8];
+    yoyo::BufferSink overflow(small);
+    yoyo::writeJson(value, overflow);
+    return !fits.overflowed() && fits.view() == R"({"a":[1,2.5,"x\ny"]})" &&
+           overflow.overflowed() && overflow.required() == 20 &&
+           overflow.view() == R"({"a":[1,)";
+  };
+
+  auto fd_sink = [&]() -> bool {
+    std::FILE* file = std::tmpfile();
+    if (file == nullptr) return false;
+    bool ok;
+    {
+      yoyo::FdSink sink(fileno(file), 256);  // 小块, 多次 flush
+      yoyo::writeJson(root, sink);
+      ok = sink.flush();
+    }
+    std::rewind(file);
+    std::string out;
+    char buffer[4096];
+    size_t n;
+    while ((n = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+      out.append(buffer, n);
+    }
+    std::fclose(file);
+    return ok && out == expected;
+  };
+
+  CHECK(string_sink() == true);
+  CHECK(buffer_sink() == true);
+  CHECK(fd_sink() == true);
+}
+
+// 测试字符串转义输出
+TEST_CASE("testing string escaping") {
+  // 逐字符的参考实现
+  auto reference = [](const std::string& str) {
+    std::string out = "\"";
+    for (unsigned char c : str) {
+      if (c == '"' || c == '\\') {
+        out += '\\';
+        out += static_cast<char>(c);
+      } else if (c == '\n') {
+        out += "\\n";
+      } else if (c == '\t') {
+        out += "\\t";
+      } else if (c == '\r') {
+        out += "\\r";
+      } else if (c == '\b') {
+        out += "\\b";
+      } else if (c == '\f') {
+        out += "\\f";
+      } else if (c < 0x20) {
+        char buffer[8];
+        std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+        out += buffer;
+      } else {
+        out += static_cast<char>(c);
+      }
+    }
+    return out + "\"";
+  };
+
+  auto all_bytes = [&]() -> bool {
+    std::string str;
+    for (int c = 1; c < 256; ++c) str += static_cast<char>(c);
+    return yoyo::JsonValue(str).writeToString() == reference(str);
+  };
+
+  auto block_boundaries = [&]() -> bool {
+    // 特殊字符落在 SIMD 块内外的各个位置
+    for (size_t len = 0; len <= 80; ++len) {
+      for (size_t pos = 0; pos < len; ++pos) {
+        for (char special : {'"', '\\', '\x01', '\n'}) {
+          std::string str(len, 'a');
+          str[pos] = special;
+          if (yoyo::JsonValue(str).writeToString() != reference(str))
+            return false;
+        }
+      }
+    }
+    return true;
+  };
+
+  auto round_trip = []() -> bool {
+    // 输出的每种转义都能被解析回原字节, 包括 '\0'
+    std::vector<std::string> strings;
+    std::string every(256, '\0');
+    for (int c = 0; c < 256; ++c) {
+      every[c] = static_cast<char>(c);
+      strings.push_back(std::string(1, static_cast<char>(c)) + "x");
+    }
+    strings.push_back(every);
+    for (const std::string& str : strings) {
+      std::string json = yoyo::JsonValue(str).writeToString();
+      for (auto mode : {yoyo::PARSEMODE::PARSE_RECURSIVE,
+                        yoyo::PARSEMODE::PARSE_INDEXED,
+                        yoyo::PARSEMODE::PARSE_ITERATIVE}) {
+        if (yoyo::parserJson(json, mode).asString() != str) return false;
+      }
+      std::string buffer = json;
+      if (yoyo::parserJsonInSitu(buffer.data(), buffer.size()).asString() !=
+          str)
+        return false;
+    }
+    return true;
+  };
+
+  CHECK(all_bytes() == true);
+  CHECK(block_boundaries() == true);
+  CHECK(round_trip() == true);
+}
+
+// 测试格式化输出
+TEST_CASE("testing pretty printer") {
+  yoyo::JsonValue value =
+      yoyo::parserJson(R"({"a":1,"b":[true,null,"s"],"c":{"d":[]},"e":{}})");
+
+  auto default_indent = [&]() -> bool {
+    yoyo::JsonWriteOptions options;
+    options.pretty = true;
+    return value.writeToString(options) == R"({
+  "a": 1,
+  "b": [
+    true,
+    null,
+    "s"
+  ],
+  "c": {
+    "d": []
+  },
+  "e": {}
+})";
+  };
+
+  auto tabs_and_compact_arrays = [&]() -> bool {
+    yoyo::JsonWriteOptions options;
+    options.pretty = true;
+    options.indentWidth = 1;
+    options.indentChar = '\t';
+    options.compactScalarArrays = true;
+    return value.writeToString(options) ==
+           "{\n\t\"a\": 1,\n\t\"b\": [true, null, \"s\"],\n\t\"c\": {\n"
+           "\t\t\"d\": []\n\t},\n\t\"e\": {}\n}";
+  };
+
+  auto deep_nesting = []() -> bool {
+    // 超过预先填好的缩进长度, 输出仍能解析回同一个文档
+    std::string json(40, '[');
+    json += "1";
+    json += std::string(40, ']');
+    yoyo::JsonWriteOptions options;
+    options.pretty = true;
+    options.indentWidth = 4;
+    std::string pretty = yoyo::parserJson(json).writeToString(options);
+    return pretty.find(std::string(4 * 40, ' ') + "1") != std::string::npos &&
+           yoyo::parserJson(pretty).writeToString() == json;
+  };
+
+  CHECK(default_indent() == true);
+  CHECK(tabs_and_compact_arrays() == true);
+  CHECK(deep_nesting() == true);
+}
+
+// 测试引用访问与移出
+TEST_CASE("testing reference accessors") {
+  auto no_copy = []() -> bool {
+    // 超出内联容量的字符串才有 std::string 成员
+    yoyo::JsonValue root =
+        yoyo::parserJson(R"({"a":[1,2,3],"s":"text longer than inline"})");
+    const yoyo::JsonValue& croot = root;
+    const auto& arr = croot["a"].getRef<yoyo::JsonValue::json_array>();
+    // 引用指向树中的同一个数组
+    root["a"].getRef<yoyo::JsonValue::json_array>().push_back(4);
+    return &arr == &croot["a"].getRef<yoyo::JsonValue::json_array>() &&
+           arr.size() == 4 && arr[3] == 4 &&
+           croot["s"].asStringView() == "text longer than inline" &&
+           croot["s"].asStringView().data() ==
+               croot["s"].getRef<std::string>().data();
+  };
+
+  auto string_views = []() -> bool {
+    std::string json = R"(["plain","esc\"aped"])";
+    yoyo::JsonValue borrowed = yoyo::parserJsonBorrowed(json);
+    yoyo::JsonValue lazy = yoyo::parserJsonLazy(json);
+    bool threw = false;
+    try {
+      lazy[1].asStringView();
+    } catch (const std::logic_error&) {
+      threw = true;
+    }
+    return borrowed[0].asStringView() == "plain" &&
+           borrowed[0].asStringView().data() == json.data() + 2 &&
+           lazy[0].asStringView() == "plain" && threw &&
+           lazy[1] == std::string("esc\"aped") &&
+           lazy[1].asString() == "esc\"aped";
+  };
+
+  auto mutable_materializes = []() -> bool {
+    std::string json = R"({"n":42,"d":1.5,"s":"str"})";
+    yoyo::JsonValue lazy = yoyo::parserJsonLazy(json);
+    lazy["n"].getRef<yoyo::JsonValue::json_int>() += 1;
+    lazy["d"].getRef<yoyo::JsonValue::json_double>() *= 2;
+    lazy["s"].getRef<std::string>() += "!";
+    return !lazy["n"].isRaw() && lazy["n"] == 43 &&
+           lazy["d"].asDouble() == 3.0 && !lazy["s"].isBorrowed() &&
+           lazy.writeToString() == R"({"n":43,"d":3.0,"s":"str!"})";
+  };
+
+  auto take_moves_out = []() -> bool {
+    yoyo::JsonValue root =
+        yoyo::parserJson(R"({"a":[1,2],"s":"long enough to be on the heap"})");
+    const char* bytes = root["s"].asStringView().data();
+    std::string s = root["s"].take<std::string>();
+    yoyo::JsonValue::json_array arr = std::move(root["a"]);
+    bool threw = false;
+    try {
+      root["a"].take<yoyo::JsonValue::json_object>();
+    } catch (const std::bad_variant_access&) {
+      threw = true;
+    }
+    return s.data() == bytes && root["s"].isNull() && arr.size() == 2 &&
+           root["a"].isNull() && threw && root.size() == 2;
+  };
+
+  CHECK(no_copy() == true);
+  CHECK(string_views() == true);
+  CHECK(mutable_materializes() == true);
+  CHECK(take_moves_out() == true);
+}
+
+// 测试不插入的键查找
+TEST_CASE("testing key lookup") {
+  const yoyo::JsonValue root = yoyo::parserJson(
+      R"({"a_rather_long_key_name":1,"b":{"c":true},"arr":[1]})");
+
+  auto find_no_insert = [&]() -> bool {
+    yoyo::JsonValue copy = root;
+    const yoyo::JsonValue* pHit = copy.find("b");
+    return pHit != nullptr && (*pHit)["c"] == true &&
+           copy.find("missing") == nullptr && copy.size() == 3 &&
+           copy["arr"].find("a") == nullptr && copy.size() == 3;
+  };
+
+  auto key_types = [&]() -> bool {
+    std::string owned = "a_rather_long_key_name";
+    // 不以 '\0' 结尾的视图也能查找
+    std::string_view slice = std::string_view("b_and_more").substr(0, 1);
+    return root.isMember(owned) && root.isMember(slice) &&
+           root.isMember("arr") && !root.isMember("zzz") &&
+           !root.isMember(42) && root[owned] == 1 &&
+           root[slice]["c"] == true && root["arr"][0] == 1;
+  };
+
+  auto mutable_insert = []() -> bool {
+    yoyo::JsonValue value;
+    std::string_view key = std::string_view("new_key_tail").substr(0, 7);
+    value[key] = 5;
+    *value.find("new_key") = 6;
+    return value.size() == 1 && value["new_key"] == 6;
+  };
+
+  CHECK(find_no_insert() == true);
+  CHECK(key_types() == true);
+  CHECK(mutable_insert() == true);
+}
+
+// 旧的节点布局: 类型标记加上以 std::string/容器为最大成员的 std::variant
+struct LegacyNode {
+  yoyo::JSONTYPE type;
+  std::variant<std::monostate, int64_t, bool, double, std::string,
+               yoyo::JsonValue::json_array, yoyo::JsonValue::json_object,
+               std::string_view, uint64_t, yoyo::JsonValue::json_raw>
+      value;
+};
+
+// 旧的键布局: 自己持有的 std::string + 借用视图 + 驻留字典
+struct LegacyKey {
+  std::string owned;
+  std::string_view borrowed;
+  const void* dict;
+};
+
+// 同一棵树按旧布局 (容器和字符串直接放在节点内) 占用的字节数
+size_t legacyMemoryUsage(const yoyo::JsonValue& value) {
+  size_t bytes = sizeof(LegacyNode);
+  if (value.isString() && !value.isBorrowed() && !value.isRaw()) {
+    bytes += yoyo::detail::stringHeapBytes(value.asString());
+  } else if (value.isArray()) {
+    const auto& arr = value.getRef<yoyo::JsonValue::json_array>();
+    bytes += (arr.capacity() - arr.size()) * sizeof(LegacyNode);
+    for (const auto& element : arr) bytes += legacyMemoryUsage(element);
+  } else if (value.isObject()) {
+    const auto& obj = value.getRef<yoyo::JsonValue::json_object>();
+    bytes += obj.heapBytes() -
+             obj.capacity() * sizeof(yoyo::JsonValue::json_member) +
+             (obj.capacity() - obj.size()) *
+                 (sizeof(LegacyKey) + sizeof(LegacyNode));
+    for (const auto& member : obj) {
+      bytes += sizeof(LegacyKey) +
+               yoyo::detail::stringHeapBytes(member.first.str()) +
+               legacyMemoryUsage(member.second);
+    }
+  }
+  return bytes;
+}
+
+// 测试紧凑节点的内存占用
+TEST_CASE("testing compact node size") {
+  std::string json = loadTestData();
+  REQUIRE(!json.empty());
+  yoyo::JsonValue root = yoyo::parserJson(json);
+  size_t compactBytes = root.memoryUsage();
+  size_t legacyBytes = legacyMemoryUsage(root);
+  MESSAGE("test_data.json DOM bytes: " << legacyBytes << " (variant node, "
+          << sizeof(LegacyNode) << " B) -> " << compactBytes
+          << " (compact node, " << sizeof(yoyo::JsonValue) << " B)");
+
+  auto node_layout = []() -> bool {
+    return sizeof(yoyo::JsonValue) == 16 &&
+           sizeof(yoyo::JsonValue) < sizeof(LegacyNode);
+  };
+
+  auto copy_and_move = [&root, compactBytes]() -> bool {
+    yoyo::JsonValue copy = root;
+    yoyo::JsonValue moved = std::move(copy);
+    // 子节点赋给祖先时先取出再释放旧值
+    moved = std::move(moved["brokers"]);
+    yoyo::JsonValue again = root["brokers"];
+    again = again;
+    return copy.isNull() && moved.isObject() &&
+           moved.writeToString() == again.writeToString() &&
+           again.memoryUsage() < compactBytes;
+  };
+
+  CHECK(node_layout() == true);
+  CHECK(compactBytes < legacyBytes);
+  CHECK(copy_and_move() == true);
+}
+
+// 测试短字符串和短键内联存放
+TEST_CASE("testing inline short strings") {
+  auto inline_values = []() -> bool {
+    std::string fits(yoyo::JsonValue::INLINE_CAPACITY, 'x');
+    std::string spills = fits + "y";
+    yoyo::JsonValue small(fits);
+    yoyo::JsonValue large(spills);
+    yoyo::JsonValue withNul(std::string("a\0b", 3));
+    yoyo::JsonValue copy = small;
+    return small.memoryUsage() == sizeof(yoyo::JsonValue) &&
+           large.memoryUsage() > sizeof(yoyo::JsonValue) && small == fits &&
+           large == spills && copy == fits && withNul.asString().size() == 3 &&
+           withNul.writeToString() == "\"a\\u0000b\"";
+  };
+
+  auto inline_keys = []() -> bool {
+    std::string fits(yoyo::JsonKey::INLINE_CAPACITY, 'k');
+    std::string spills = fits + "k";
+    yoyo::JsonKey small(fits);
+    yoyo::JsonKey large(spills);
+    yoyo::JsonKey largeCopy = large;
+    yoyo::JsonKey moved = std::move(largeCopy);
+    yoyo::JsonKey borrowed = yoyo::JsonKey::borrow(spills);
+    yoyo::JsonKeyDict dict;
+    yoyo::JsonKey interned = dict.intern(spills);
+    return sizeof(yoyo::JsonKey) == 24 && small.isInline() &&
+           small.heapBytes() == 0 && !large.isInline() &&
+           large.heapBytes() == spills.size() && moved == large &&
+           moved.view().data() != large.view().data() && borrowed == large &&
+           borrowed.view().data() == spills.data() && interned == large &&
+           interned == dict.intern(spills) && small.view() == fits;
+  };
+
+  auto parsed_tree = []() -> bool {
+    std::string json =
+        R"({"state":"INIT","source":"learned","a_key_longer_than_inline":)"
+        R"("a value longer than inline"})";
+    yoyo::JsonValue root = yoyo::parserJson(json);
+    // 两个短值不分配内存, 只有长值持有 std::string
+    yoyo::JsonValue state = root["state"];
+    root["state"].getRef<std::string>() += "IALIZED";
+    return state.memoryUsage() == sizeof(yoyo::JsonValue) &&
+           root["source"] == std::string("learned") &&
+           root["state"] == std::string("INITIALIZED") &&
+           root.writeToString() ==
+               R"({"state":"INITIALIZED","source":"learned",)"
+               R"("a_key_longer_than_inline":"a value longer than inline"})";
+  };
+
+  CHECK(inline_values() == true);
+  CHECK(inline_keys() == true);
+  CHECK(parsed_tree() == true);
+}
+
+// 把 SAX 事件记录成文本, 便于比较
+struct SaxRecorder : yoyo::JsonSaxHandler {
+  std::string events;
+  size_t stopAfter{static_cast<size_t>(-1)};  // 收到这么多个事件后停止
+
+  bool record(const std::string& event) {
+    events += event + " ";
+    return --stopAfter != 0;
+  }
+  bool null() { return record("null"); }
+  bool boolean(bool value) { return record(value ? "true" : "false"); }
+  bool int64(int64_t value) { return record("i:" + std::to_string(value)); }
+  bool uint64(uint64_t value) { return record("u:" + std::to_string(value)); }
+  bool float64(double value) { return record("d:" + std::to_string(value)); }
+  bool string(std::string_view value) {
+    return record("s:" + std::string(value));
+  }
+  bool key(std::string_view value) { return record("k:" + std::string(value)); }
+  bool startObject() { return record("{"); }
+  bool endObject() { return record("}"); }
+  bool startArray() { return record("["); }
+  bool endArray() { return record("]"); }
+};
+
+// 测试 SAX 事件接口
+TEST_CASE("testing sax handler") {
+  auto event_order = []() -> bool {
+    SaxRecorder recorder;
+    yoyo::JsonStatus status = yoyo::parserJsonSax(
+        R"({"a":[1,-2,1.5,18446744073709551615,true,null],"b\n":"x\ty",)"
+        R"("c":{},"d":[]})",
+        recorder);
+    return status.ok() &&
+           recorder.events ==
+               "{ k:a [ i:1 i:-2 d:1.500000 u:18446744073709551615 true null "
+               "] k:b\n s:x\ty k:c { } k:d [ ] } ";
+  };
+
+  auto borrowed_views = []() -> bool {
+    // 不含转义的字符串直接指向输入
+    struct ViewCheck : yoyo::JsonSaxHandler {
+      const char* begin;
+      const char* end;
+      bool inside{true};
+      bool string(std::string_view value) {
+        inside = inside && value.data() >= begin && value.data() < end;
+        return true;
+      }
+    };
+    std::string json = R"(["plain","also plain"])";
+    ViewCheck check;
+    check.begin = json.data();
+    check.end = json.data() + json.size();
+    return yoyo::parserJsonSax(json, check).ok() && check.inside;
+  };
+
+  auto same_errors_as_tree = []() -> bool {
+    const char* inputs[] = {"",          "[1,]",       "{\"a\" 1}",
+                            "{\"a\":1,}", "[1 2]",      "[tru]",
+                            "\"abc",     "[1e999]",    "[-]",
+                            "{1:2}",     "[1] x",      "[\"\\q\"]",
+                            "[[[[",      "{\"a\":[}"};
+    for (const char* input : inputs) {
+      yoyo::JsonSaxHandler handler;
+      yoyo::JsonStatus status = yoyo::parserJsonSax(input, handler);
+      yoyo::JsonResult result = yoyo::tryParseJson(input);
+      if (status.ok() || status.error != result.error ||
+          status.offset != result.offset)
+        return false;
+    }
+    return true;
+  };
+
+  auto abort_and_depth = []() -> bool {
+    SaxRecorder recorder;
+    recorder.stopAfter = 3;
+    yoyo::JsonStatus stopped = yoyo::parserJsonSax("[1,2,3]", recorder);
+    // 超过栈上位图的深度
+    std::string deep = std::string(3000, '[') + std::string(3000, ']');
+    yoyo::JsonSaxHandler handler;
+    yoyo::JsonParser limited(deep);
+    yoyo::JsonStatus tooDeep = limited.parseSax(handler);
+    yoyo::JsonParser parser(deep);
+    parser.setMaxDepth(4000);
+    return stopped.error == yoyo::JSONERROR::ERROR_ABORTED &&
+           recorder.events == "[ i:1 i:2 " &&
+           tooDeep.error == yoyo::JSONERROR::ERROR_DEPTH_EXCEEDED &&
+           tooDeep.offset == 64 && parser.parseSax(handler).ok();
+  };
+
+  CHECK(event_order() == true);
+  CHECK(borrowed_views() == true);
+  CHECK(same_errors_as_tree() == true);
+  CHECK(abort_and_depth() == true);
+}
+
+// 测试只校验模式
+TEST_CASE("testing validation") {
+  auto agrees_with_parser = []() -> bool {
+    std::vector<std::string> inputs = {
+        loadTestData(),    "[1,2,3]",     "{\"a\":\"b\\n\"}", "  true ",
+        "",                "[1,]",        "{\"a\" 1}",        "{\"a\":1,}",
+        "[1 2]",           "[tru]",       "\"abc",            "[1e999]",
+        "[-]",             "{1:2}",       "[1] x",            "[\"\\q\"]",
+        "[[[[",            "{\"a\":[}",   "[\"a\tb\"]",       "01",
+        "-01",             "[01]",        "\"\\u00e9\"",      "\"\\/\"",
+        "\"\\b\\f\"",      "\"\\ud800\"", "\"\\udc00\"",      "\"\\/\\t\"",
+        "\"\\uD83D\\uDE00\"", "{\"a\":1,\"a\":2}"};
+    for (const std::string& input : inputs) {
+      yoyo::JsonStatus status = yoyo::validateJson(input);
+      yoyo::JsonResult result = yoyo::tryParseJson(input);
+      if (status.ok() != result.ok()) return false;
+      if (!status.ok() && (status.error != result.error ||
+                           status.offset != result.offset))
+        return false;
+    }
+    return true;
+  };
+
+  auto utf8_checks = []() -> bool {
+    // 合法: 2/3/4 字节序列, 以及 ASCII 快速路径之后的多字节字符
+    std::string valid = "[\"\xC3\xA9\xE4\xB8\xAD\xF0\x9F\x98\x80\"," +
+                        std::string(40, ' ') + "\"\xF4\x8F\xBF\xBF\"]";
+    if (!yoyo::validateJson(valid, true).ok()) return false;
+    const char* invalid[] = {
+        "[\"\xC0\x80\"]",          // 过长编码
+        "[\"\xE0\x9F\xBF\"]",      // 过长编码
+        "[\"\xED\xA0\x80\"]",      // 代理项
+        "[\"\xF4\x90\x80\x80\"]",  // 超过 U+10FFFF
+        "[\"\xE4\xB8\"]",          // 截断
+        "[\"\x80\"]",              // 单独的续字节
+        "[\"\xFF\"]"};
+    for (const char* input : invalid) {
+      yoyo::JsonStatus status = yoyo::validateJson(input, true);
+      // 不检查 UTF-8 时与 tryParse 一样接受
+      if (status.error != yoyo::JSONERROR::ERROR_INVALID_UTF8 ||
+          status.offset != 2 || !yoyo::validateJson(input).ok())
+        return false;
+    }
+    // 两种错误都存在时报告靠前的一个
+    yoyo::JsonStatus grammarFirst = yoyo::validateJson("[1,]\"\xFF\"", true);
+    yoyo::JsonStatus utf8First = yoyo::validateJson("[\"\xFF\",]", true);
+    return grammarFirst.error == yoyo::JSONERROR::ERROR_INVALID_VALUE &&
+           utf8First.error == yoyo::JSONERROR::ERROR_INVALID_UTF8;
+  };
+
+  auto grammar_edges = []() -> bool {
+    auto error_at = [](const char* json, yoyo::JSONERROR error,
+                       size_t offset) {
+      yoyo::JsonStatus status = yoyo::validateJson(json);
+      return status.error == error && status.offset == offset;
+    };
+    for (const char* json : {"0", "-0", "[0, 10, 0.5]", R"("\u00e9")",
+                             R"("\/")", R"("\b")", R"("\f")"}) {
+      if (!yoyo::validateJson(json).ok()) return false;
+    }
+    return error_at("01", yoyo::JSONERROR::ERROR_INVALID_NUMBER, 1) &&
+           error_at("-01", yoyo::JSONERROR::ERROR_INVALID_NUMBER, 2) &&
+           error_at("[01]", yoyo::JSONERROR::ERROR_INVALID_NUMBER, 2) &&
+           error_at(R"("\ud800")", yoyo::JSONERROR::ERROR_INVALID_STRING, 7) &&
+           error_at(R"("\udc00")", yoyo::JSONERROR::ERROR_INVALID_STRING, 3);
+  };
+
+  auto duplicate_keys = []() -> bool {
+    // 超过索引阈值的对象, 重复的键在最后
+    std::string wide = "{";
+    for (int i = 0; i < 40; i++) wide += "\"k" + std::to_string(i) + "\":0,";
+    wide += "\"k7\":1}";
+    std::vector<std::string> inputs = {
+        R"({"a":1,"\u0061":2})",        // 转义后相同
+        R"({"a":{"b":1,"b":2}})",       // 内层对象
+        R"({"a":{"a":1},"b":{"a":2},"a":3})",
+        R"([{"a":1},{"a":1}])",         // 不同对象中的同名键合法
+        R"({"a\u00e9":1,"a\u00e8":2})",
+        wide};
+    for (const std::string& input : inputs) {
+      yoyo::JsonStatus status = yoyo::validateJson(input);
+      yoyo::JsonResult result = yoyo::tryParseJson(input);
+      if (status.ok() != result.ok()) return false;
+      if (!status.ok() && (status.error != result.error ||
+                           status.offset != result.offset))
+        return false;
+    }
+    yoyo::JsonStatus status = yoyo::validateJson(wide);
+    return status.error == yoyo::JSONERROR::ERROR_DUPLICATE_KEY &&
+           status.offset == wide.size() - 7;
+  };
+
+  CHECK(agrees_with_parser() == true);
+  CHECK(utf8_checks() == true);
+  CHECK(grammar_edges() == true);
+  CHECK(duplicate_keys() == true);
+}